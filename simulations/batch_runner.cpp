@@ -0,0 +1,219 @@
+// BATCH RUNNER - PARAMETER SWEEPS OF MECHANICS SCENARIOS
+// ARC PROJECTS - SIMULATION PROJECT 16-10-2026
+// classical_mechanics_solver.cpp evaluates one hardcoded scenario (u = 0, a = 9.81, t = 3). This runner reads a
+// scenario file describing a grid over u, a and t, evaluates every combination with the SUVAT kernels from
+// headers/units.h across a thread pool, and streams the results into a columnar binary file.
+//
+// Scenario file: one line per parameter, "name start stop count", '#' starts a comment. Missing parameters default to
+// the values of the original solver. See scenarios/free_fall_sweep.txt.
+//
+// Output file layout (little endian):
+//   header     "ARCCOL01", uint32 column count, per column a 16-byte zero-padded name, uint64 total rows
+//   row groups uint32 rows, then each column as `rows` contiguous float32 values
+// Columns are u, a, t, v, s. Row groups are written in scenario order, so row k of the file is scenario k.
+//
+// Keeping per-scenario overhead in nanoseconds:
+//   - the grid index is decoded once per row group, then advanced like an odometer (no division per scenario)
+//   - each worker fills whole row groups in column buffers, so the kernel writes straight into the output layout
+//   - a batch of row groups is computed in parallel while the previous batch is being written
+//
+// Build: g++ -std=c++20 -O2 -pthread batch_runner.cpp -o batch_runner
+// Usage: ./batch_runner scenarios/free_fall_sweep.txt results.bin
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "headers/thread_pool.h"
+#include "headers/units.h"
+
+struct ParameterRange {
+    double start = 0.0;
+    double stop = 0.0;
+    std::uint64_t count = 1;
+
+    float at(std::uint64_t k) const {
+        return static_cast<float>(count > 1 ? start + (stop - start) * static_cast<double>(k) / (count - 1) : start);
+    }
+};
+
+// parameters in odometer order: t varies fastest, then a, then u
+struct Scenario {
+    ParameterRange u{0.0, 0.0, 1};
+    ParameterRange a{9.81, 9.81, 1};
+    ParameterRange t{3.0, 3.0, 1};
+
+    std::uint64_t size() const { return u.count * a.count * t.count; }
+};
+
+bool read_scenario(const std::string& path, Scenario& scenario) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Could not open scenario file " << path << std::endl;
+        return false;
+    }
+    std::string line;
+    int line_number = 0;
+    while (std::getline(in, line)) {
+        line_number++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string name;
+        ParameterRange range;
+        if (!(fields >> name)) {
+            continue;
+        }
+        if (!(fields >> range.start >> range.stop >> range.count) || range.count == 0) {
+            std::cerr << path << ":" << line_number << ": expected 'name start stop count'" << std::endl;
+            return false;
+        }
+        if (name == "u") scenario.u = range;
+        else if (name == "a") scenario.a = range;
+        else if (name == "t") scenario.t = range;
+        else {
+            std::cerr << path << ":" << line_number << ": unknown parameter '" << name << "'" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+constexpr std::size_t column_count = 5;
+constexpr std::size_t rows_per_group = 1 << 16;
+
+struct RowGroup {
+    std::uint32_t rows = 0;
+    std::array<std::vector<float>, column_count> columns;  // u, a, t, v, s
+};
+
+// Evaluates scenarios [first, first + rows) into a row group.
+void evaluate(const Scenario& sc, std::uint64_t first, std::uint32_t rows, RowGroup& group) {
+    group.rows = rows;
+    for (std::vector<float>& column : group.columns) {
+        column.resize(rows);
+    }
+    float* u_out = group.columns[0].data();
+    float* a_out = group.columns[1].data();
+    float* t_out = group.columns[2].data();
+    float* v_out = group.columns[3].data();
+    float* s_out = group.columns[4].data();
+
+    std::uint64_t it = first % sc.t.count;
+    std::uint64_t ia = (first / sc.t.count) % sc.a.count;
+    std::uint64_t iu = first / (sc.t.count * sc.a.count);
+    Velocity<float> u(sc.u.at(iu));
+    Acceleration<float> a(sc.a.at(ia));
+    for (std::uint32_t r = 0; r < rows; r++) {
+        Time<float> t(sc.t.at(it));
+        u_out[r] = u.value();
+        a_out[r] = a.value();
+        t_out[r] = t.value();
+        v_out[r] = suvat::final_velocity(u, a, t).value();
+        s_out[r] = suvat::displacement(u, a, t).value();
+        if (++it == sc.t.count) {
+            it = 0;
+            if (++ia == sc.a.count) {
+                ia = 0;
+                iu++;
+                u = Velocity<float>(sc.u.at(iu));
+            }
+            a = Acceleration<float>(sc.a.at(ia));
+        }
+    }
+}
+
+void write_header(std::ofstream& out, std::uint64_t rows) {
+    static const char* names[column_count] = {"u", "a", "t", "v", "s"};
+    out.write("ARCCOL01", 8);
+    std::uint32_t columns = column_count;
+    out.write(reinterpret_cast<const char*>(&columns), sizeof(columns));
+    for (const char* name : names) {
+        char padded[16] = {};
+        std::strncpy(padded, name, sizeof(padded) - 1);
+        out.write(padded, sizeof(padded));
+    }
+    out.write(reinterpret_cast<const char*>(&rows), sizeof(rows));
+}
+
+void write_group(std::ofstream& out, const RowGroup& group) {
+    out.write(reinterpret_cast<const char*>(&group.rows), sizeof(group.rows));
+    for (const std::vector<float>& column : group.columns) {
+        out.write(reinterpret_cast<const char*>(column.data()), static_cast<std::streamsize>(group.rows * sizeof(float)));
+    }
+}
+
+int main(int argc, char** argv) {
+    std::cout << "Batch runner for SUVAT parameter sweeps." << std::endl;
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <scenario file> <output file>" << std::endl;
+        return 1;
+    }
+    Scenario scenario;
+    if (!read_scenario(argv[1], scenario)) {
+        return 1;
+    }
+    std::ofstream out(argv[2], std::ios::binary);
+    if (!out) {
+        std::cerr << "Could not open output file " << argv[2] << std::endl;
+        return 1;
+    }
+
+    const std::uint64_t total = scenario.size();
+    const std::uint64_t groups = (total + rows_per_group - 1) / rows_per_group;
+    std::cout << "Scenarios: " << total << " (" << scenario.u.count << " x " << scenario.a.count << " x "
+              << scenario.t.count << "), row groups: " << groups << std::endl;
+
+    ThreadPool pool;
+    const std::size_t batch = 4 * pool.size();  // row groups computed per parallel round
+    std::vector<RowGroup> computing(batch), writing(batch);
+    std::size_t pending = 0;  // row groups in `writing` waiting to be flushed
+    std::future<void> writer;
+
+    write_header(out, total);
+    auto start = std::chrono::steady_clock::now();
+    double compute_seconds = 0.0;
+    for (std::uint64_t g0 = 0; g0 < groups; g0 += batch) {
+        std::size_t count = static_cast<std::size_t>(std::min<std::uint64_t>(batch, groups - g0));
+        auto compute_start = std::chrono::steady_clock::now();
+        pool.parallel_for(0, count, [&](std::size_t lo, std::size_t hi, unsigned) {
+            for (std::size_t k = lo; k < hi; k++) {
+                std::uint64_t first = (g0 + k) * rows_per_group;
+                std::uint32_t rows = static_cast<std::uint32_t>(std::min<std::uint64_t>(rows_per_group, total - first));
+                evaluate(scenario, first, rows, computing[k]);
+            }
+        });
+        compute_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - compute_start).count();
+
+        // hand the finished batch to the writer thread and keep computing into the other buffer
+        if (writer.valid()) {
+            writer.get();
+        }
+        std::swap(computing, writing);
+        pending = count;
+        writer = std::async(std::launch::async, [&out, &writing, pending] {
+            for (std::size_t k = 0; k < pending; k++) {
+                write_group(out, writing[k]);
+            }
+        });
+    }
+    if (writer.valid()) {
+        writer.get();
+    }
+    out.close();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double bytes = static_cast<double>(total) * column_count * sizeof(float);
+    std::cout << "Threads: " << pool.size() << std::endl;
+    std::cout << "Compute: " << compute_seconds << " s, " << compute_seconds * 1e9 / total << " ns/scenario" << std::endl;
+    std::cout << "Total including output: " << elapsed << " s, " << elapsed * 1e9 / total << " ns/scenario, "
+              << bytes / elapsed / 1e6 << " MB/s written" << std::endl;
+    return out.good() ? 0 : 1;
+}
@@ -1,6 +1,9 @@
 #include <iostream>
 #include <cmath>
 
+#include "headers/units.h"
+
+using namespace unit_literals;
 
 int main() {
 
@@ -11,14 +14,19 @@ int main() {
     // v = final velocity
     // a = accleration
     // t = time elapsed
+    // Units are carried in the types (see headers/units.h), so e.g. adding a time to a velocity will not compile.
+
+    // Length<float> s = 0.0_m;
+    constexpr Velocity<float> u = 0.0_mps;
+    constexpr Acceleration<float> a_down = 9.81_mps2;
+    constexpr Time<float> t = 3.0_s;
 
-    // float s = 0.0;
-    float u = 0.0;
-    float v_down = 0.0;
-    float a_down = 9.81;
-    float t = 3.0;
+    // evaluated by the compiler; nothing is left to compute at runtime
+    constexpr Velocity<float> v_down = suvat::final_velocity(u, a_down, t);
+    static_assert(v_down.value() > 29.42f && v_down.value() < 29.44f);
+    constexpr Length<float> s_down = suvat::displacement(u, a_down, t);
 
-    v_down = u + a_down*t;
-    std::cout << "Final velocity reached: " << v_down << "m/s" << std::endl;
+    std::cout << "Final velocity reached: " << v_down.value() << "m/s" << std::endl;
+    std::cout << "Distance fallen: " << s_down.value() << "m" << std::endl;
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,69 @@
+// CLOTH SIMULATION - HANGING CLOTH BENCHMARK
+// ARC PROJECTS - SIMULATION PROJECT 16-10-2026
+// Moves beyond the single body of classical_mechanics_solver.cpp to a sheet of particles joined by springs. A cloth
+// pinned along its top edge falls under gravity; distance constraints are solved with position-based dynamics in
+// graph-coloured batches (see headers/cloth.h).
+//
+// Reports:
+//   1. colouring - number of colours and constraints per colour
+//   2. throughput - constraint projections per second against the thread count
+//   3. convergence - remaining stretch after a step vs solver iterations and wall time
+//
+// Build: g++ -std=c++20 -O2 -pthread cloth_simulation.cpp -o cloth_simulation
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "headers/cloth.h"
+
+int main() {
+    std::cout << "Cloth simulation: position-based dynamics with coloured constraint batches." << std::endl;
+
+    // 400 x 400 particles gives just under a million constraints
+    const int side = 400;
+    const float dt = 1.0f / 60.0f;
+    Cloth base = Cloth::hanging(side, side, 0.01f);
+    std::cout << "\nParticles: " << base.x.size() << ", constraints: " << base.constraints.size()
+              << ", colours: " << base.colours() << std::endl;
+    for (std::size_t c = 0; c < base.colours(); c++) {
+        std::cout << "  colour " << c << ": " << base.batch_start[c + 1] - base.batch_start[c] << " constraints" << std::endl;
+    }
+
+    unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "\nthreads   ms/iteration   M constraints/s" << std::endl;
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        ThreadPool pool(threads);
+        Cloth cloth = base;
+        cloth.step(dt, 1, pool);  // warm up and allocate prediction buffers
+        const int iterations = 20;
+        auto start = std::chrono::steady_clock::now();
+        for (int k = 0; k < iterations; k++) {
+            cloth.project(pool);
+        }
+        auto end = std::chrono::steady_clock::now();
+        double per_iteration = std::chrono::duration<double>(end - start).count() / iterations;
+        std::cout << threads << "\t" << per_iteration * 1e3 << "\t" << cloth.constraints.size() / per_iteration / 1e6 << std::endl;
+        if (threads * 2 > max_threads && threads != max_threads) {
+            threads = max_threads / 2;
+        }
+    }
+
+    // let the cloth fall for a while, then measure how far one step's projection converges
+    ThreadPool pool;
+    Cloth cloth = Cloth::hanging(40, 40, 0.05f);
+    for (int frame = 0; frame < 60; frame++) {
+        cloth.step(dt, 40, pool);
+    }
+    std::cout << "\nConvergence within one step (40 x 40 cloth after 1 s of falling)" << std::endl;
+    std::cout << "iterations   rms stretch   time (ms)" << std::endl;
+    for (int iterations : {1, 2, 5, 10, 20, 50, 100}) {
+        Cloth trial = cloth;
+        auto start = std::chrono::steady_clock::now();
+        trial.step(dt, iterations, pool);
+        auto end = std::chrono::steady_clock::now();
+        std::cout << iterations << "\t" << trial.residual() << "\t"
+                  << std::chrono::duration<double>(end - start).count() * 1e3 << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,151 @@
+// DETERMINISTIC REDUCTIONS - REPRODUCIBILITY AND OVERHEAD
+// ARC PROJECTS - SIMULATION PROJECT 16-10-2026
+// Sums the kinetic energy, momentum and maximum speed of a large particle system with 1 to 8 threads, three ways:
+//   naive - one partial sum per thread chunk, added in thread order (what the solvers did so far)
+//   tree  - fixed-block pairwise tree from headers/deterministic_reduce.h
+//   exact - superaccumulator, exact until the final conversion to double
+// and prints the results as hex floats so any difference in the last bit is visible, with the time per reduction.
+// The float displacements of classical_mechanics_solver.cpp are summed the same way, and the Lennard-Jones engine is
+// run in its deterministic mode at several thread counts.
+//
+// Build: g++ -std=c++20 -O2 -pthread deterministic_reductions.cpp -o deterministic_reductions
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "headers/deterministic_reduce.h"
+#include "headers/particle_system.h"
+#include "headers/short_range.h"
+
+struct Momentum {
+    double px = 0.0, py = 0.0;
+};
+
+// sum of term(i) with one partial per thread chunk: the grouping changes with the thread count
+template <typename Term>
+double naive_sum(ThreadPool& pool, std::size_t n, Term&& term) {
+    std::vector<double> parts(pool.size(), 0.0);
+    pool.parallel_for(0, n, [&](std::size_t lo, std::size_t hi, unsigned worker) {
+        double s = 0.0;
+        for (std::size_t i = lo; i < hi; i++) {
+            s += term(i);
+        }
+        parts[worker] = s;
+    });
+    double total = 0.0;
+    for (double s : parts) {
+        total += s;
+    }
+    return total;
+}
+
+template <typename Fn>
+double time_ms(Fn&& fn, int repeats) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; r++) {
+        fn();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count() * 1e3 / repeats;
+}
+
+int main() {
+    std::cout << "Deterministic reductions across thread counts." << std::endl;
+
+    // velocities spread over many orders of magnitude make the rounding differences easy to see
+    const std::size_t n = 2'000'000;
+    ParticleSystem p;
+    p.reserve(n);
+    std::mt19937_64 rng(34);
+    std::uniform_real_distribution<double> unit(-1.0, 1.0);
+    std::uniform_real_distribution<double> decades(-3.0, 3.0);
+    for (std::size_t i = 0; i < n; i++) {
+        double scale = std::pow(10.0, decades(rng));
+        p.add(unit(rng), unit(rng), scale * unit(rng), scale * unit(rng), 1.0 + 0.5 * unit(rng));
+    }
+    auto energy = [&](std::size_t i) { return 0.5 * p.m[i] * (p.vx[i] * p.vx[i] + p.vy[i] * p.vy[i]); };
+
+    // SUVAT displacements in float, as in classical_mechanics_solver.cpp
+    std::vector<float> displacement(n);
+    for (std::size_t i = 0; i < n; i++) {
+        float u = static_cast<float>(p.vx[i]), a = -9.81f, t = static_cast<float>(1.0 + p.x[i]);
+        displacement[i] = u * t + 0.5f * a * t * t;
+    }
+
+    std::cout << std::hexfloat;
+    std::cout << "\nthreads   kinetic energy: naive / tree / exact   momentum x (tree)   max speed   displacement (exact)"
+              << std::endl;
+    for (unsigned threads : {1u, 2u, 3u, 4u, 7u, 8u}) {
+        ThreadPool pool(threads);
+        double naive = naive_sum(pool, n, energy);
+        double tree = deterministic_sum(pool, n, energy);
+        double exact = exact_sum(pool, n, energy);
+        Momentum momentum = tree_reduce(
+            pool, 0, n, Momentum{},
+            [&](std::size_t lo, std::size_t hi) {
+                Momentum m;
+                for (std::size_t i = lo; i < hi; i++) {
+                    m.px += p.m[i] * p.vx[i];
+                    m.py += p.m[i] * p.vy[i];
+                }
+                return m;
+            },
+            [](Momentum a, Momentum b) { return Momentum{a.px + b.px, a.py + b.py}; });
+        double max_speed = tree_reduce(
+            pool, 0, n, 0.0,
+            [&](std::size_t lo, std::size_t hi) {
+                double m = 0.0;
+                for (std::size_t i = lo; i < hi; i++) {
+                    m = std::max(m, p.vx[i] * p.vx[i] + p.vy[i] * p.vy[i]);
+                }
+                return std::sqrt(m);
+            },
+            [](double a, double b) { return std::max(a, b); });
+        double s = exact_sum(pool, n, [&](std::size_t i) { return static_cast<double>(displacement[i]); });
+        std::cout << threads << "\t" << naive << " " << tree << " " << exact << "\t" << momentum.px << "\t" << max_speed
+                  << "\t" << s << std::endl;
+    }
+    std::cout << std::defaultfloat;
+
+    // overhead against the naive reduction
+    const int repeats = 10;
+    std::cout << "\nthreads   naive (ms)   tree (ms)   exact (ms)   tree overhead   exact overhead" << std::endl;
+    for (unsigned threads : {1u, 2u, 4u, 8u}) {
+        ThreadPool pool(threads);
+        volatile double sink = 0.0;
+        double t_naive = time_ms([&] { sink = naive_sum(pool, n, energy); }, repeats);
+        double t_tree = time_ms([&] { sink = deterministic_sum(pool, n, energy); }, repeats);
+        double t_exact = time_ms([&] { sink = exact_sum(pool, n, energy); }, repeats);
+        std::cout << threads << "\t" << t_naive << "\t" << t_tree << "\t" << t_exact << "\t" << t_tree / t_naive << "x\t"
+                  << t_exact / t_naive << "x" << std::endl;
+    }
+
+    // a Lennard-Jones run in deterministic mode: forces are per particle already, only the energy was a reduction
+    std::cout << "\nLennard-Jones energy after 20 steps, deterministic mode" << std::endl;
+    std::cout << std::hexfloat;
+    for (unsigned threads : {1u, 2u, 3u, 4u}) {
+        ThreadPool pool(threads);
+        const std::size_t side = 60;
+        const double spacing = 1.0 / std::sqrt(0.7);
+        ParticleSystem fluid;
+        std::mt19937 vrng(9);
+        std::normal_distribution<double> velocity(0.0, 1.0);
+        for (std::size_t j = 0; j < side; j++) {
+            for (std::size_t i = 0; i < side; i++) {
+                fluid.add((i + 0.5) * spacing, (j + 0.5) * spacing, velocity(vrng), velocity(vrng), 1.0);
+            }
+        }
+        ShortRangeEngine<LennardJones> engine(LennardJones{}, side * spacing, pool);
+        engine.deterministic = true;
+        LeapfrogIntegrator<ShortRangeEngine<LennardJones>> integrator{engine};
+        integrator.prime(fluid);
+        for (int step = 0; step < 20; step++) {
+            integrator.step(fluid, 0.005);
+        }
+        std::cout << threads << "\t" << kinetic_energy(fluid) + engine.potential_energy() << std::endl;
+    }
+    return 0;
+}
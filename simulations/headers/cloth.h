@@ -0,0 +1,183 @@
+// CLOTH - POSITION-BASED DYNAMICS WITH COLOURED CONSTRAINTS
+// ARC PROJECTS - SIMULATION PROJECT 16-10-2026
+// A mass-spring cloth solved with position-based dynamics (Mueller et al. 2007). Instead of integrating spring
+// forces, each step predicts positions from velocities and then projects distance constraints directly, which is
+// unconditionally stable at any stiffness.
+//
+// Gauss-Seidel projection is sequential in principle: two constraints sharing a particle must not update it at the
+// same time. The constraints are therefore graph-coloured so that no two constraints of one colour share a particle.
+// Each colour is then a batch that can be projected fully in parallel without locks, and the colours run one after
+// another. A regular cloth needs only a handful of colours.
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "thread_pool.h"
+
+struct DistanceConstraint {
+    std::uint32_t a, b;
+    float rest_length;
+    float stiffness;  // 0..1, fraction of the error corrected per projection
+};
+
+class Cloth {
+public:
+    std::vector<float> x, y, z;        // positions
+    std::vector<float> px, py, pz;     // predicted positions
+    std::vector<float> vx, vy, vz;     // velocities
+    std::vector<float> inv_mass;       // zero pins a particle in place
+    std::vector<DistanceConstraint> constraints;  // grouped by colour after build_batches()
+    std::vector<std::size_t> batch_start;         // colour c owns constraints [batch_start[c], batch_start[c + 1])
+    float gravity = -9.81f;
+
+    std::size_t colours() const { return batch_start.empty() ? 0 : batch_start.size() - 1; }
+
+    static constexpr int serial_colour = 64;  // the overflow batch, for constraints past 64 colours
+
+    // Rectangular cloth of nx by ny particles hanging in the x-z plane from its top row.
+    static Cloth hanging(int nx, int ny, float spacing) {
+        Cloth c;
+        const std::size_t n = static_cast<std::size_t>(nx) * ny;
+        c.x.resize(n); c.y.resize(n); c.z.resize(n);
+        c.vx.assign(n, 0.0f); c.vy.assign(n, 0.0f); c.vz.assign(n, 0.0f);
+        c.inv_mass.assign(n, 1.0f);
+        auto id = [nx](int i, int j) { return static_cast<std::uint32_t>(j * nx + i); };
+        for (int j = 0; j < ny; j++) {
+            for (int i = 0; i < nx; i++) {
+                // start horizontal so the cloth swings down under gravity
+                c.x[id(i, j)] = i * spacing;
+                c.y[id(i, j)] = j * spacing;
+                c.z[id(i, j)] = 0.0f;
+            }
+        }
+        for (int i = 0; i < nx; i++) {
+            c.inv_mass[id(i, 0)] = 0.0f;
+        }
+        auto link = [&](std::uint32_t a, std::uint32_t b, float stiffness) {
+            float dx = c.x[a] - c.x[b], dy = c.y[a] - c.y[b], dz = c.z[a] - c.z[b];
+            c.constraints.push_back({a, b, std::sqrt(dx * dx + dy * dy + dz * dz), stiffness});
+        };
+        for (int j = 0; j < ny; j++) {
+            for (int i = 0; i < nx; i++) {
+                if (i + 1 < nx) link(id(i, j), id(i + 1, j), 1.0f);                    // structural
+                if (j + 1 < ny) link(id(i, j), id(i, j + 1), 1.0f);
+                if (i + 1 < nx && j + 1 < ny) link(id(i, j), id(i + 1, j + 1), 0.5f);  // shear
+                if (i > 0 && j + 1 < ny) link(id(i, j), id(i - 1, j + 1), 0.5f);
+                if (i + 2 < nx) link(id(i, j), id(i + 2, j), 0.2f);                    // bending
+                if (j + 2 < ny) link(id(i, j), id(i, j + 2), 0.2f);
+            }
+        }
+        c.build_batches();
+        return c;
+    }
+
+    // Greedy colouring: each constraint takes the lowest colour not yet used at either of its particles, tracked as
+    // a bitmask per particle. Constraints are then stably regrouped by colour. A constraint that finds all 64
+    // colours taken goes to an extra batch, serial_colour, which project() runs on one thread.
+    void build_batches() {
+        std::vector<std::uint64_t> used(x.size(), 0);
+        std::vector<std::uint8_t> colour(constraints.size());
+        int count = 0;
+        for (std::size_t k = 0; k < constraints.size(); k++) {
+            std::uint64_t taken = used[constraints[k].a] | used[constraints[k].b];
+            int c = taken == ~std::uint64_t(0) ? serial_colour : std::countr_one(taken);
+            colour[k] = static_cast<std::uint8_t>(c);
+            if (c < serial_colour) {
+                used[constraints[k].a] |= std::uint64_t(1) << c;
+                used[constraints[k].b] |= std::uint64_t(1) << c;
+            }
+            count = std::max(count, c + 1);
+        }
+        batch_start.assign(count + 1, 0);
+        for (std::uint8_t c : colour) {
+            batch_start[c + 1]++;
+        }
+        for (int c = 0; c < count; c++) {
+            batch_start[c + 1] += batch_start[c];
+        }
+        std::vector<DistanceConstraint> grouped(constraints.size());
+        std::vector<std::size_t> fill(batch_start.begin(), batch_start.end() - 1);
+        for (std::size_t k = 0; k < constraints.size(); k++) {
+            grouped[fill[colour[k]]++] = constraints[k];
+        }
+        constraints.swap(grouped);
+    }
+
+    void step(float dt, int iterations, ThreadPool& pool) {
+        const std::size_t n = x.size();
+        px.resize(n); py.resize(n); pz.resize(n);
+        pool.parallel_for(0, n, [&](std::size_t lo, std::size_t hi, unsigned) {
+            for (std::size_t i = lo; i < hi; i++) {
+                if (inv_mass[i] > 0.0f) {
+                    vz[i] += dt * gravity;
+                }
+                px[i] = x[i] + dt * vx[i];
+                py[i] = y[i] + dt * vy[i];
+                pz[i] = z[i] + dt * vz[i];
+            }
+        });
+        for (int iteration = 0; iteration < iterations; iteration++) {
+            project(pool);
+        }
+        const float inv_dt = 1.0f / dt;
+        pool.parallel_for(0, n, [&](std::size_t lo, std::size_t hi, unsigned) {
+            for (std::size_t i = lo; i < hi; i++) {
+                vx[i] = (px[i] - x[i]) * inv_dt;
+                vy[i] = (py[i] - y[i]) * inv_dt;
+                vz[i] = (pz[i] - z[i]) * inv_dt;
+                x[i] = px[i]; y[i] = py[i]; z[i] = pz[i];
+            }
+        });
+    }
+
+    // One Gauss-Seidel sweep: colours in sequence, constraints within a colour in parallel.
+    void project(ThreadPool& pool) {
+        for (std::size_t c = 0; c < colours(); c++) {
+            auto batch = [&](std::size_t lo, std::size_t hi, unsigned) {
+                for (std::size_t k = lo; k < hi; k++) {
+                    const DistanceConstraint& d = constraints[k];
+                    float wa = inv_mass[d.a], wb = inv_mass[d.b];
+                    float w = wa + wb;
+                    if (w == 0.0f) {
+                        continue;
+                    }
+                    float dx = px[d.a] - px[d.b], dy = py[d.a] - py[d.b], dz = pz[d.a] - pz[d.b];
+                    float length = std::sqrt(dx * dx + dy * dy + dz * dz);
+                    if (length < 1e-9f) {
+                        continue;
+                    }
+                    float s = d.stiffness * (length - d.rest_length) / (length * w);
+                    px[d.a] -= wa * s * dx; py[d.a] -= wa * s * dy; pz[d.a] -= wa * s * dz;
+                    px[d.b] += wb * s * dx; py[d.b] += wb * s * dy; pz[d.b] += wb * s * dz;
+                }
+            };
+            if (c == static_cast<std::size_t>(serial_colour)) {
+                batch(batch_start[c], batch_start[c + 1], 0u);  // its constraints may share particles
+            }
+            else {
+                pool.parallel_for(batch_start[c], batch_start[c + 1], batch);
+            }
+        }
+    }
+
+    // Root-mean-square relative stretch of the structural and shear constraints at the predicted positions.
+    double residual() const {
+        double sum = 0.0;
+        std::size_t count = 0;
+        for (const DistanceConstraint& d : constraints) {
+            if (d.stiffness < 0.5f) {
+                continue;
+            }
+            double dx = px[d.a] - px[d.b], dy = py[d.a] - py[d.b], dz = pz[d.a] - pz[d.b];
+            double error = (std::sqrt(dx * dx + dy * dy + dz * dz) - d.rest_length) / d.rest_length;
+            sum += error * error;
+            count++;
+        }
+        return std::sqrt(sum / std::max<std::size_t>(count, 1));
+    }
+};
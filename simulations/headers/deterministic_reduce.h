@@ -0,0 +1,180 @@
+// DETERMINISTIC REDUCTIONS
+// ARC PROJECTS - SIMULATION PROJECT 16-10-2026
+// Floating-point addition is not associative, so a parallel sum whose partial sums follow the thread chunks gives a
+// slightly different answer for every thread count. Two ways to make reductions bitwise reproducible from 1 to N
+// threads:
+//
+//   tree_reduce     - the range is cut into fixed blocks whose size does not depend on the thread count. Each block
+//                     is reduced sequentially, and the block results are combined in a fixed pairwise tree. Threads
+//                     only decide who computes which block, never the order of the additions. Works for any
+//                     combine operation (sums of structs, min/max, ...).
+//   Superaccumulator - exact summation. Every double is added into a wide fixed-point integer covering the whole
+//                     double exponent range, so the sum carries no rounding at all and partial accumulators can be
+//                     merged in any order. Converted to a double only once at the end.
+//
+// Max and min are associative and exact already, so any parallel order gives the same result; they only need the
+// tree when mixed with sums in one pass.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "thread_pool.h"
+
+constexpr std::size_t deterministic_block = 4096;
+
+// Reduces [begin, end) to one value. block(lo, hi) reduces one block sequentially; combine(a, b) merges two results.
+template <typename T, typename BlockFn, typename Combine>
+T tree_reduce(ThreadPool& pool, std::size_t begin, std::size_t end, T identity, BlockFn&& block, Combine&& combine) {
+    if (end <= begin) {
+        return identity;
+    }
+    const std::size_t blocks = (end - begin + deterministic_block - 1) / deterministic_block;
+    std::vector<T> partial(blocks, identity);
+    pool.parallel_for(0, blocks, [&](std::size_t lo, std::size_t hi, unsigned) {
+        for (std::size_t b = lo; b < hi; b++) {
+            std::size_t first = begin + b * deterministic_block;
+            std::size_t last = std::min(end, first + deterministic_block);
+            partial[b] = block(first, last);
+        }
+    });
+    // pairwise tree over the block results: the shape depends only on the number of blocks
+    for (std::size_t stride = 1; stride < blocks; stride *= 2) {
+        for (std::size_t b = 0; b + stride < blocks; b += 2 * stride) {
+            partial[b] = combine(partial[b], partial[b + stride]);
+        }
+    }
+    return partial[0];
+}
+
+// Sum of term(i) over [0, n), reproducible for any thread count.
+template <typename Term>
+double deterministic_sum(ThreadPool& pool, std::size_t n, Term&& term) {
+    return tree_reduce(
+        pool, 0, n, 0.0,
+        [&](std::size_t lo, std::size_t hi) {
+            double s = 0.0;
+            for (std::size_t i = lo; i < hi; i++) {
+                s += term(i);
+            }
+            return s;
+        },
+        [](double a, double b) { return a + b; });
+}
+
+// Exact accumulator for doubles (floats convert to double exactly). Limb k holds the bits of weight
+// 2^(32k - bias) in its low 32 bits; the upper bits of each signed 64-bit limb absorb carries, so carries are only
+// propagated every 2^29 additions and when the value is read.
+class Superaccumulator {
+public:
+    Superaccumulator() : limbs(limb_count, 0) {}
+
+    void add(double x) {
+        if (!std::isfinite(x)) {
+            special += x;
+            return;
+        }
+        if (x == 0.0) {
+            return;
+        }
+        int exponent;
+        double fraction = std::frexp(std::fabs(x), &exponent);  // |x| = fraction * 2^exponent, fraction in [0.5, 1)
+        std::uint64_t mantissa = static_cast<std::uint64_t>(std::ldexp(fraction, 53));
+        int position = exponent - 53 + bias;
+        int k = position / 32, shift = position % 32;
+        std::uint64_t low = (mantissa & mask) << shift;
+        std::uint64_t high = (mantissa >> 32) << shift;
+        std::int64_t d0 = static_cast<std::int64_t>(low & mask);
+        std::int64_t d1 = static_cast<std::int64_t>((low >> 32) + (high & mask));
+        std::int64_t d2 = static_cast<std::int64_t>(high >> 32);
+        if (x > 0.0) {
+            limbs[k] += d0; limbs[k + 1] += d1; limbs[k + 2] += d2;
+        } else {
+            limbs[k] -= d0; limbs[k + 1] -= d1; limbs[k + 2] -= d2;
+        }
+        if (++additions == carry_interval) {
+            propagate();
+        }
+    }
+
+    // Adds another accumulator. Integer addition, so merging is exact and order independent.
+    void merge(const Superaccumulator& other) {
+        propagate();
+        Superaccumulator copy = other;
+        copy.propagate();
+        for (int k = 0; k < limb_count; k++) {
+            limbs[k] += copy.limbs[k];
+        }
+        special += copy.special;
+        propagate();
+    }
+
+    // A deterministic double close to the exact sum: the top three digits are added in double arithmetic, so the
+    // result can be an ulp away from the correctly rounded sum. After carry propagation the representation is
+    // unique, so the result depends only on the exact value, not on the order of the additions.
+    double value() {
+        propagate();
+        if (special != 0.0) {  // also true for NaN
+            return special;
+        }
+        bool negative = limbs[limb_count - 1] < 0;
+        std::vector<std::int64_t> digits = limbs;
+        if (negative) {
+            for (std::int64_t& d : digits) {
+                d = -d;
+            }
+            normalise(digits);
+        }
+        // the top three non-zero digits hold at least 65 significant bits, more than a double keeps
+        int top = limb_count - 1;
+        while (top >= 0 && digits[top] == 0) {
+            top--;
+        }
+        double sum = 0.0;
+        for (int k = top; k >= 0 && k > top - 3; k--) {
+            sum += std::ldexp(static_cast<double>(digits[k]), 32 * k - bias);
+        }
+        return negative ? -sum : sum;
+    }
+
+private:
+    static constexpr int bias = 1126;       // 2^-1126 is the weight of the lowest mantissa bit of the smallest subnormal
+    static constexpr int limb_count = 70;   // 2240 bits: the double range plus headroom for huge sums
+    static constexpr std::uint64_t mask = 0xffffffffu;
+    static constexpr std::uint32_t carry_interval = 1u << 29;
+
+    std::vector<std::int64_t> limbs;
+    std::uint32_t additions = 0;
+    double special = 0.0;  // infinities and NaNs, which have no fixed-point representation
+
+    static void normalise(std::vector<std::int64_t>& digits) {
+        for (int k = 0; k + 1 < limb_count; k++) {
+            std::int64_t carry = digits[k] >> 32;  // arithmetic shift: floor division by 2^32
+            digits[k] -= carry * (std::int64_t(1) << 32);
+            digits[k + 1] += carry;
+        }
+    }
+
+    void propagate() {
+        normalise(limbs);
+        additions = 0;
+    }
+};
+
+// Exact sum of term(i) over [0, n): one accumulator per worker, merged at the end.
+template <typename Term>
+double exact_sum(ThreadPool& pool, std::size_t n, Term&& term) {
+    std::vector<Superaccumulator> parts(pool.size());
+    pool.parallel_for(0, n, [&](std::size_t lo, std::size_t hi, unsigned worker) {
+        for (std::size_t i = lo; i < hi; i++) {
+            parts[worker].add(term(i));
+        }
+    });
+    for (std::size_t w = 1; w < parts.size(); w++) {
+        parts[0].merge(parts[w]);
+    }
+    return parts[0].value();
+}
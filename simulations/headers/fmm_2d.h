@@ -0,0 +1,301 @@
+// FAST MULTIPOLE METHOD (2D)
+// ARC PROJECTS - SIMULATION PROJECT 16-10-2026
+// Greengard-Rokhlin fast multipole method for the planar (logarithmic) gravity used by DirectSumEngine.
+// Positions are treated as complex numbers z = x + iy, and the potential of a point mass is m log(z - z_j). Far away
+// from a cluster of masses the sum of these logs is a Laurent series in (z - centre), truncated after `order` terms.
+//
+// Algorithm on a uniform quadtree:
+//   1. P2M  - leaf multipole expansions from the particles inside each leaf
+//   2. M2M  - shift child expansions into their parent, moving up the tree
+//   3. M2L  - convert well-separated multipoles into local (Taylor) expansions, at every level
+//   4. L2L  - push local expansions down into the children
+//   5. L2P  - evaluate the leaf local expansion at each particle, plus direct sums with the adjacent leaves
+// Every stage is linear in the number of particles or cells, so the cost is O(N p^2) rather than O(N^2).
+// Raising `order` (p) shrinks the truncation error roughly as 2^-p at the price of p^2 work per cell.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+#include "particle_system.h"
+
+struct FmmEngine {
+    double G = 1.0;
+    double softening = 1e-3;
+    int order = 10;             // number of expansion terms p
+    std::size_t leaf_size = 32; // target particles per leaf, decides the tree depth
+
+    using cplx = std::complex<double>;
+
+    void compute_accelerations(ParticleSystem& p) {
+        const std::size_t n = p.size();
+        if (n == 0) {
+            return;
+        }
+        setup(p);
+        bin_particles(p);
+        upward_pass();
+        interaction_pass();
+        downward_pass();
+        evaluate(p);
+    }
+
+private:
+    int levels = 0;
+    double box_x = 0.0, box_y = 0.0, box_size = 1.0;
+    std::vector<double> binom;                           // binom[a * (2p + 1) + b] = C(a, b)
+    std::vector<std::vector<cplx>> multipole;            // per level, ncells * (p + 1)
+    std::vector<std::vector<cplx>> local;                // per level, ncells * (p + 1)
+    std::vector<std::size_t> cell_start;                 // leaf cell -> first particle in sorted order
+    std::vector<std::size_t> order_index;                // sorted slot -> original particle index
+    std::vector<double> sx, sy, sm;                      // particle data in leaf order
+
+    int side(int level) const { return 1 << level; }
+    std::size_t terms() const { return static_cast<std::size_t>(order) + 1; }
+    double choose(int a, int b) const { return binom[a * (2 * order + 1) + b]; }
+
+    cplx centre(int level, int ix, int iy) const {
+        double w = box_size / side(level);
+        return {box_x + (ix + 0.5) * w, box_y + (iy + 0.5) * w};
+    }
+
+    void setup(const ParticleSystem& p) {
+        const std::size_t n = p.size();
+        double min_x = p.x[0], max_x = p.x[0], min_y = p.y[0], max_y = p.y[0];
+        for (std::size_t i = 1; i < n; i++) {
+            min_x = std::min(min_x, p.x[i]); max_x = std::max(max_x, p.x[i]);
+            min_y = std::min(min_y, p.y[i]); max_y = std::max(max_y, p.y[i]);
+        }
+        box_size = std::max(max_x - min_x, max_y - min_y) * (1.0 + 1e-9) + 1e-12;
+        box_x = min_x;
+        box_y = min_y;
+
+        // choose depth so that leaves hold roughly leaf_size particles, at least two levels so M2L has work to do
+        levels = 2;
+        while (levels < 12 && (n >> (2 * levels)) > leaf_size) {
+            levels++;
+        }
+
+        const int width = 2 * order + 1;
+        if (binom.size() != static_cast<std::size_t>(width * width)) {
+            binom.assign(width * width, 0.0);
+            for (int a = 0; a < width; a++) {
+                binom[a * width] = 1.0;
+                for (int b = 1; b <= a; b++) {
+                    binom[a * width + b] = binom[(a - 1) * width + b - 1] + ((b <= a - 1) ? binom[(a - 1) * width + b] : 0.0);
+                }
+            }
+        }
+
+        multipole.resize(levels + 1);
+        local.resize(levels + 1);
+        for (int l = 0; l <= levels; l++) {
+            std::size_t cells = static_cast<std::size_t>(side(l)) * side(l);
+            multipole[l].assign(cells * terms(), cplx(0.0, 0.0));
+            local[l].assign(cells * terms(), cplx(0.0, 0.0));
+        }
+    }
+
+    // Counting sort of particles into leaf cells, copying their data into leaf order for cache-friendly access.
+    void bin_particles(const ParticleSystem& p) {
+        const std::size_t n = p.size();
+        const int s = side(levels);
+        const std::size_t cells = static_cast<std::size_t>(s) * s;
+        const double inv_w = s / box_size;
+
+        std::vector<std::size_t> cell_of(n);
+        cell_start.assign(cells + 1, 0);
+        for (std::size_t i = 0; i < n; i++) {
+            int ix = std::min(s - 1, static_cast<int>((p.x[i] - box_x) * inv_w));
+            int iy = std::min(s - 1, static_cast<int>((p.y[i] - box_y) * inv_w));
+            cell_of[i] = static_cast<std::size_t>(iy) * s + ix;
+            cell_start[cell_of[i] + 1]++;
+        }
+        for (std::size_t c = 0; c < cells; c++) {
+            cell_start[c + 1] += cell_start[c];
+        }
+        std::vector<std::size_t> fill(cell_start.begin(), cell_start.end() - 1);
+        order_index.resize(n);
+        sx.resize(n); sy.resize(n); sm.resize(n);
+        for (std::size_t i = 0; i < n; i++) {
+            std::size_t slot = fill[cell_of[i]]++;
+            order_index[slot] = i;
+            sx[slot] = p.x[i];
+            sy[slot] = p.y[i];
+            sm[slot] = p.m[i];
+        }
+    }
+
+    void upward_pass() {
+        const std::size_t P = terms();
+        const int s = side(levels);
+
+        // P2M: a_0 = sum m, a_k = -sum m z^k / k
+        for (int iy = 0; iy < s; iy++) {
+            for (int ix = 0; ix < s; ix++) {
+                std::size_t c = static_cast<std::size_t>(iy) * s + ix;
+                cplx* a = &multipole[levels][c * P];
+                cplx zc = centre(levels, ix, iy);
+                for (std::size_t j = cell_start[c]; j < cell_start[c + 1]; j++) {
+                    cplx z = cplx(sx[j], sy[j]) - zc;
+                    cplx zk = z;
+                    a[0] += sm[j];
+                    for (std::size_t k = 1; k < P; k++) {
+                        a[k] -= sm[j] * zk / static_cast<double>(k);
+                        zk *= z;
+                    }
+                }
+            }
+        }
+
+        // M2M: b_l = -a_0 z0^l / l + sum_{k=1..l} a_k z0^(l-k) C(l-1, k-1), z0 = child centre - parent centre
+        std::vector<cplx> z0_pow(P);
+        for (int l = levels - 1; l >= 0; l--) {
+            const int ps = side(l);
+            for (int iy = 0; iy < ps; iy++) {
+                for (int ix = 0; ix < ps; ix++) {
+                    cplx* b = &multipole[l][(static_cast<std::size_t>(iy) * ps + ix) * P];
+                    cplx zp = centre(l, ix, iy);
+                    for (int cy = 0; cy < 2; cy++) {
+                        for (int cx = 0; cx < 2; cx++) {
+                            int jx = 2 * ix + cx, jy = 2 * iy + cy;
+                            const cplx* a = &multipole[l + 1][(static_cast<std::size_t>(jy) * 2 * ps + jx) * P];
+                            cplx z0 = centre(l + 1, jx, jy) - zp;
+                            z0_pow[0] = 1.0;
+                            for (std::size_t k = 1; k < P; k++) {
+                                z0_pow[k] = z0_pow[k - 1] * z0;
+                            }
+                            b[0] += a[0];
+                            for (std::size_t m = 1; m < P; m++) {
+                                cplx sum = -a[0] * z0_pow[m] / static_cast<double>(m);
+                                for (std::size_t k = 1; k <= m; k++) {
+                                    sum += a[k] * z0_pow[m - k] * choose(m - 1, k - 1);
+                                }
+                                b[m] += sum;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // M2L for every cell from level 2 down: sources are the children of the parent's neighbours that are not
+    // themselves adjacent to the target cell (at most 27 in 2D).
+    void interaction_pass() {
+        const std::size_t P = terms();
+        std::vector<cplx> inv_pow(2 * P);
+        for (int l = 2; l <= levels; l++) {
+            const int s = side(l);
+            for (int iy = 0; iy < s; iy++) {
+                for (int ix = 0; ix < s; ix++) {
+                    cplx* b = &local[l][(static_cast<std::size_t>(iy) * s + ix) * P];
+                    cplx zt = centre(l, ix, iy);
+                    int px = ix / 2, py = iy / 2;
+                    for (int jy = std::max(0, 2 * (py - 1)); jy < std::min(s, 2 * (py + 2)); jy++) {
+                        for (int jx = std::max(0, 2 * (px - 1)); jx < std::min(s, 2 * (px + 2)); jx++) {
+                            if (std::abs(jx - ix) <= 1 && std::abs(jy - iy) <= 1) {
+                                continue;
+                            }
+                            const cplx* a = &multipole[l][(static_cast<std::size_t>(jy) * s + jx) * P];
+                            cplx z0 = centre(l, jx, jy) - zt;
+                            cplx inv = 1.0 / z0;
+                            inv_pow[0] = 1.0;
+                            for (std::size_t k = 1; k < 2 * P; k++) {
+                                inv_pow[k] = inv_pow[k - 1] * inv;
+                            }
+                            // the constant term b_0 only shifts the potential and does not affect the force
+                            for (std::size_t m = 1; m < P; m++) {
+                                cplx sum = -a[0] / static_cast<double>(m);
+                                double sign = -1.0;
+                                for (std::size_t k = 1; k < P; k++) {
+                                    sum += sign * a[k] * inv_pow[k] * choose(m + k - 1, k - 1);
+                                    sign = -sign;
+                                }
+                                b[m] += sum * inv_pow[m];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // L2L: b_l = sum_{k>=l} a_k C(k, l) (-z0)^(k-l), z0 = parent centre - child centre
+    void downward_pass() {
+        const std::size_t P = terms();
+        std::vector<cplx> z_pow(P);
+        for (int l = 2; l < levels; l++) {
+            const int s = side(l);
+            for (int iy = 0; iy < s; iy++) {
+                for (int ix = 0; ix < s; ix++) {
+                    const cplx* a = &local[l][(static_cast<std::size_t>(iy) * s + ix) * P];
+                    cplx zp = centre(l, ix, iy);
+                    for (int cy = 0; cy < 2; cy++) {
+                        for (int cx = 0; cx < 2; cx++) {
+                            int jx = 2 * ix + cx, jy = 2 * iy + cy;
+                            cplx* b = &local[l + 1][(static_cast<std::size_t>(jy) * 2 * s + jx) * P];
+                            cplx minus_z0 = centre(l + 1, jx, jy) - zp;
+                            z_pow[0] = 1.0;
+                            for (std::size_t k = 1; k < P; k++) {
+                                z_pow[k] = z_pow[k - 1] * minus_z0;
+                            }
+                            for (std::size_t m = 0; m < P; m++) {
+                                cplx sum = 0.0;
+                                for (std::size_t k = m; k < P; k++) {
+                                    sum += a[k] * choose(k, m) * z_pow[k - m];
+                                }
+                                b[m] += sum;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void evaluate(ParticleSystem& p) const {
+        const std::size_t P = terms();
+        const int s = side(levels);
+        const double eps2 = softening * softening;
+        for (int iy = 0; iy < s; iy++) {
+            for (int ix = 0; ix < s; ix++) {
+                std::size_t c = static_cast<std::size_t>(iy) * s + ix;
+                const cplx* b = &local[levels][c * P];
+                cplx zc = centre(levels, ix, iy);
+                for (std::size_t i = cell_start[c]; i < cell_start[c + 1]; i++) {
+                    // far field: derivative of the local expansion, w = sum l b_l z^(l-1)
+                    cplx z = cplx(sx[i], sy[i]) - zc;
+                    cplx w = 0.0;
+                    for (std::size_t k = P - 1; k >= 1; k--) {
+                        w = w * z + static_cast<double>(k) * b[k];
+                    }
+                    // the force vector (x, y) corresponds to conj(w)
+                    double axi = -w.real();
+                    double ayi = w.imag();
+
+                    // near field: softened direct sum over this leaf and its neighbours
+                    for (int jy = std::max(0, iy - 1); jy <= std::min(s - 1, iy + 1); jy++) {
+                        for (int jx = std::max(0, ix - 1); jx <= std::min(s - 1, ix + 1); jx++) {
+                            std::size_t d = static_cast<std::size_t>(jy) * s + jx;
+                            for (std::size_t j = cell_start[d]; j < cell_start[d + 1]; j++) {
+                                double dx = sx[i] - sx[j];
+                                double dy = sy[i] - sy[j];
+                                double r2 = dx * dx + dy * dy + eps2;
+                                double f = (i == j) ? 0.0 : sm[j] / r2;
+                                axi -= f * dx;
+                                ayi -= f * dy;
+                            }
+                        }
+                    }
+                    p.ax[order_index[i]] = G * axi;
+                    p.ay[order_index[i]] = G * ayi;
+                }
+            }
+        }
+    }
+};
@@ -0,0 +1,316 @@
+// HARD DISCS - EVENT-DRIVEN SIMULATION
+// ARC PROJECTS - SIMULATION PROJECT 16-10-2026
+// Hard discs move in straight lines between instantaneous elastic collisions, so a time-stepped integrator spends
+// almost all of its work moving particles that interact with nothing. An event-driven engine instead jumps from one
+// collision to the next. Between events every disc follows the constant-velocity SUVAT motion s = u t, so the time
+// at which two discs touch is the root of a quadratic, |dr + dv t| = sigma, solved in closed form.
+//
+// Bookkeeping (after Rapaport, and Lubachevsky's delayed states):
+//   - each disc carries its own clock and is only moved when it takes part in an event
+//   - each disc keeps exactly one pending event, its earliest collision or cell crossing; the events live in an
+//     indexed binary heap keyed by disc, so a disc's event can be replaced in place
+//   - collisions are not searched for among all discs, only in the 3 x 3 block of cells around a disc. A disc that
+//     could be hit from further away must first cross into a neighbouring cell, which is itself an event
+//   - lazy invalidation: a collision event remembers the partner's collision count when it was predicted. If the
+//     partner has collided since, the event is stale and the disc is simply re-predicted when it reaches the top
+//
+// The box is periodic. Cells are at least one diameter wide and sized to hold about one disc each.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+class HardDiscGas {
+public:
+    struct Disc {
+        double x, y, vx, vy;
+        double t;               // time at which x, y are valid
+        double mass;
+        std::uint32_t cell;
+        std::uint32_t collisions;
+    };
+
+    HardDiscGas(double box, double diameter) : box(box), sigma(diameter) {}
+
+    void add(double x, double y, double vx, double vy, double mass = 1.0) {
+        discs.push_back({x, y, vx, vy, now, mass, 0, 0});
+        primed = false;
+    }
+
+    std::size_t size() const { return discs.size(); }
+    double time() const { return now; }
+    double diameter() const { return sigma; }
+    std::uint64_t collision_count() const { return collisions; }
+    std::uint64_t crossing_count() const { return crossings; }
+    std::uint64_t stale_count() const { return stale; }
+
+    // Processes events up to time t_end and brings every disc to that time.
+    void advance_to(double t_end) {
+        if (!primed) {
+            prime();
+        }
+        while (!heap.empty() && heap[0].time <= t_end) {
+            process(heap[0].disc);
+        }
+        now = t_end;
+        for (Disc& d : discs) {
+            move(d, t_end);
+        }
+    }
+
+    // Position of disc i at the current time (valid after advance_to).
+    const Disc& disc(std::size_t i) const { return discs[i]; }
+
+    double kinetic_energy() const {
+        double e = 0.0;
+        for (const Disc& d : discs) {
+            e += 0.5 * d.mass * (d.vx * d.vx + d.vy * d.vy);
+        }
+        return e;
+    }
+
+    // Smallest centre distance over all neighbouring pairs divided by the diameter; below 1 means overlap.
+    double min_separation() const {
+        double best = std::numeric_limits<double>::infinity();
+        for (std::uint32_t i = 0; i < discs.size(); i++) {
+            for_neighbours(discs[i].cell, [&](std::uint32_t j) {
+                if (j > i) {
+                    double dx = wrap(discs[j].x - discs[i].x), dy = wrap(discs[j].y - discs[i].y);
+                    best = std::min(best, std::sqrt(dx * dx + dy * dy) / sigma);
+                }
+            });
+        }
+        return best;
+    }
+
+private:
+    static constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::uint32_t crossing = none - 1;  // partner value for a cell-crossing event
+
+    struct HeapEntry {
+        double time;  // kept next to the disc id so sifting does not chase into the event array
+        std::uint32_t disc;
+    };
+
+    struct Event {
+        double time = std::numeric_limits<double>::infinity();
+        std::uint32_t partner = none;
+        std::uint32_t partner_collisions = 0;
+        int dx = 0, dy = 0;  // cell step for a crossing
+    };
+
+    double box, sigma;
+    int cells = 3;
+    double cell_size = 1.0;
+    double now = 0.0;
+    bool primed = false;
+    std::vector<Disc> discs;
+    std::vector<std::uint32_t> head, next, prev;  // intrusive doubly linked list of discs per cell
+    std::vector<Event> events;                    // one pending event per disc
+    std::vector<HeapEntry> heap;                  // binary min-heap of discs ordered by event time
+    std::vector<std::uint32_t> heap_index;        // position of each disc in the heap
+    std::uint64_t collisions = 0, crossings = 0, stale = 0;
+
+    // minimum image for a separation known to lie within one box length
+    double wrap(double d) const {
+        if (d > 0.5 * box) return d - box;
+        if (d < -0.5 * box) return d + box;
+        return d;
+    }
+
+    static void move(Disc& d, double t) {
+        double dt = t - d.t;
+        d.x += d.vx * dt;
+        d.y += d.vy * dt;
+        d.t = t;
+    }
+
+    // Bins the discs and predicts every first event. Cells are at least a diameter wide, and wider at low density so
+    // that a cell holds about one disc: narrower cells only add crossing events without removing candidates.
+    void prime() {
+        const std::size_t n = discs.size();
+        double per_disc = std::sqrt(box * box / std::max<std::size_t>(n, 1));
+        cells = std::max(3, static_cast<int>(box / std::max(sigma, per_disc)));
+        cell_size = box / cells;
+        head.assign(static_cast<std::size_t>(cells) * cells, none);
+        next.assign(n, none);
+        prev.assign(n, none);
+        for (std::uint32_t i = 0; i < n; i++) {
+            Disc& d = discs[i];
+            move(d, now);
+            d.x -= box * std::floor(d.x / box);
+            d.y -= box * std::floor(d.y / box);
+            int cx = std::min(cells - 1, static_cast<int>(d.x / cell_size));
+            int cy = std::min(cells - 1, static_cast<int>(d.y / cell_size));
+            d.cell = static_cast<std::uint32_t>(cy * cells + cx);
+            link(i);
+        }
+        events.assign(n, Event{});
+        heap.resize(n);
+        heap_index.resize(n);
+        for (std::uint32_t i = 0; i < n; i++) {
+            heap[i] = {events[i].time, i};
+            heap_index[i] = i;
+        }
+        for (std::uint32_t i = 0; i < n; i++) {
+            predict(i);
+        }
+        primed = true;
+    }
+
+    void link(std::uint32_t i) {
+        std::uint32_t c = discs[i].cell;
+        prev[i] = none;
+        next[i] = head[c];
+        if (head[c] != none) {
+            prev[head[c]] = i;
+        }
+        head[c] = i;
+    }
+
+    void unlink(std::uint32_t i) {
+        if (prev[i] != none) {
+            next[prev[i]] = next[i];
+        } else {
+            head[discs[i].cell] = next[i];
+        }
+        if (next[i] != none) {
+            prev[next[i]] = prev[i];
+        }
+    }
+
+    template <typename Fn>
+    void for_neighbours(std::uint32_t cell, Fn&& fn) const {
+        int cx = static_cast<int>(cell % cells), cy = static_cast<int>(cell / cells);
+        for (int oy = -1; oy <= 1; oy++) {
+            int ny = (cy + oy + cells) % cells;
+            for (int ox = -1; ox <= 1; ox++) {
+                int nx = (cx + ox + cells) % cells;
+                for (std::uint32_t j = head[static_cast<std::size_t>(ny) * cells + nx]; j != none; j = next[j]) {
+                    fn(j);
+                }
+            }
+        }
+    }
+
+    // Earliest future event of disc i. The disc is first brought to the current time: predicting from an older clock
+    // against a partner whose velocity has changed since would extrapolate the partner backwards along the wrong path.
+    void predict(std::uint32_t i) {
+        Disc& a = discs[i];
+        move(a, now);
+        Event e;
+
+        // cell crossing: the first wall of the current cell reached along each axis
+        int cx = static_cast<int>(a.cell % cells), cy = static_cast<int>(a.cell / cells);
+        double tx = std::numeric_limits<double>::infinity(), ty = tx;
+        if (a.vx > 0.0) tx = ((cx + 1) * cell_size - a.x) / a.vx;
+        else if (a.vx < 0.0) tx = (cx * cell_size - a.x) / a.vx;
+        if (a.vy > 0.0) ty = ((cy + 1) * cell_size - a.y) / a.vy;
+        else if (a.vy < 0.0) ty = (cy * cell_size - a.y) / a.vy;
+        if (tx < ty) {
+            e = {a.t + std::max(tx, 0.0), crossing, 0, a.vx > 0.0 ? 1 : -1, 0};
+        } else if (ty < std::numeric_limits<double>::infinity()) {
+            e = {a.t + std::max(ty, 0.0), crossing, 0, 0, a.vy > 0.0 ? 1 : -1};
+        }
+
+        // collisions: solve |dr + dv s| = sigma for the smaller root s, with dr taken at disc i's clock
+        const double sigma2 = sigma * sigma;
+        for_neighbours(a.cell, [&](std::uint32_t j) {
+            if (j == i) {
+                return;
+            }
+            const Disc& b = discs[j];
+            double lag = a.t - b.t;
+            double dx = wrap(b.x + b.vx * lag - a.x), dy = wrap(b.y + b.vy * lag - a.y);
+            double dvx = b.vx - a.vx, dvy = b.vy - a.vy;
+            double bdot = dx * dvx + dy * dvy;
+            if (bdot >= 0.0) {
+                return;  // moving apart
+            }
+            double v2 = dvx * dvx + dvy * dvy;
+            double c = dx * dx + dy * dy - sigma2;
+            double discriminant = bdot * bdot - v2 * c;
+            if (discriminant < 0.0) {
+                return;  // passing by
+            }
+            // c / (-b + sqrt(d)) is the small root without cancellation; slight overlaps from rounding give s = 0
+            double s = std::max(0.0, c / (-bdot + std::sqrt(discriminant)));
+            double t = a.t + s;
+            if (t < e.time) {
+                e = {t, j, b.collisions, 0, 0};
+            }
+        });
+        events[i] = e;
+        heap[heap_index[i]].time = e.time;
+        sift(heap_index[i]);
+    }
+
+    void process(std::uint32_t i) {
+        Event e = events[i];
+        Disc& a = discs[i];
+        now = e.time;
+        if (e.partner == crossing) {
+            move(a, e.time);
+            unlink(i);
+            int cx = static_cast<int>(a.cell % cells) + e.dx, cy = static_cast<int>(a.cell / cells) + e.dy;
+            // wrapping the cell index and the position together keeps them consistent at the box edge
+            if (cx < 0) { cx += cells; a.x += box; }
+            if (cx >= cells) { cx -= cells; a.x -= box; }
+            if (cy < 0) { cy += cells; a.y += box; }
+            if (cy >= cells) { cy -= cells; a.y -= box; }
+            a.cell = static_cast<std::uint32_t>(cy * cells + cx);
+            link(i);
+            crossings++;
+            predict(i);
+            return;
+        }
+        Disc& b = discs[e.partner];
+        if (b.collisions != e.partner_collisions) {
+            stale++;
+            predict(i);
+            return;
+        }
+        move(a, e.time);
+        move(b, e.time);
+        double dx = wrap(b.x - a.x), dy = wrap(b.y - a.y);
+        double dvx = b.vx - a.vx, dvy = b.vy - a.vy;
+        double r2 = dx * dx + dy * dy;
+        // impulse along the line of centres; equal and opposite, so momentum and energy are conserved
+        double j = 2.0 * a.mass * b.mass * (dx * dvx + dy * dvy) / ((a.mass + b.mass) * r2);
+        a.vx += j * dx / a.mass; a.vy += j * dy / a.mass;
+        b.vx -= j * dx / b.mass; b.vy -= j * dy / b.mass;
+        a.collisions++;
+        b.collisions++;
+        collisions++;
+        predict(i);
+        predict(e.partner);
+    }
+
+    // Restores heap order for the entry at position k after its key changed in either direction.
+    void sift(std::size_t k) {
+        auto key = [&](std::size_t h) { return heap[h].time; };
+        auto swap_entries = [&](std::size_t p, std::size_t q) {
+            std::swap(heap[p], heap[q]);
+            heap_index[heap[p].disc] = static_cast<std::uint32_t>(p);
+            heap_index[heap[q].disc] = static_cast<std::uint32_t>(q);
+        };
+        while (k > 0 && key(k) < key((k - 1) / 2)) {
+            swap_entries(k, (k - 1) / 2);
+            k = (k - 1) / 2;
+        }
+        while (true) {
+            std::size_t smallest = k, l = 2 * k + 1, r = l + 1;
+            if (l < heap.size() && key(l) < key(smallest)) smallest = l;
+            if (r < heap.size() && key(r) < key(smallest)) smallest = r;
+            if (smallest == k) {
+                return;
+            }
+            swap_entries(k, smallest);
+            k = smallest;
+        }
+    }
+};
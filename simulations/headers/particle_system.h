@@ -0,0 +1,98 @@
+// PARTICLE SYSTEM - SHARED STORAGE AND INTEGRATORS
+// ARC PROJECTS - SIMULATION PROJECT 16-10-2026
+// Particle storage shared by the N-body style solvers in this folder. Particles are kept as a structure of arrays
+// (one std::vector per component) so that force kernels walk contiguous memory and the compiler can vectorise them.
+//
+// A force engine is any type providing:
+//     void compute_accelerations(ParticleSystem& particles);
+// which overwrites ax/ay for every particle. The integrators below are templated on the engine, so swapping the
+// direct sum for a tree or multipole method is a one-word change at the call site.
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+struct ParticleSystem {
+    std::vector<double> x, y;    // position (m)
+    std::vector<double> vx, vy;  // velocity (m/s)
+    std::vector<double> ax, ay;  // acceleration (m/s^2), written by the force engine
+    std::vector<double> m;       // mass (kg)
+
+    std::size_t size() const { return x.size(); }
+
+    void reserve(std::size_t n) {
+        x.reserve(n); y.reserve(n);
+        vx.reserve(n); vy.reserve(n);
+        ax.reserve(n); ay.reserve(n);
+        m.reserve(n);
+    }
+
+    void add(double px, double py, double pvx, double pvy, double mass) {
+        x.push_back(px); y.push_back(py);
+        vx.push_back(pvx); vy.push_back(pvy);
+        ax.push_back(0.0); ay.push_back(0.0);
+        m.push_back(mass);
+    }
+};
+
+// Kinetic energy, sum of 1/2 m v^2.
+inline double kinetic_energy(const ParticleSystem& p) {
+    double e = 0.0;
+    for (std::size_t i = 0; i < p.size(); i++) {
+        e += 0.5 * p.m[i] * (p.vx[i] * p.vx[i] + p.vy[i] * p.vy[i]);
+    }
+    return e;
+}
+
+// Reference O(N^2) engine for planar gravity. In two dimensions the gravitational potential is logarithmic, so the
+// pairwise acceleration falls off as 1/r rather than 1/r^2. Plummer softening keeps close encounters finite.
+struct DirectSumEngine {
+    double G = 1.0;
+    double softening = 1e-3;
+
+    void compute_accelerations(ParticleSystem& p) const {
+        const std::size_t n = p.size();
+        const double eps2 = softening * softening;
+        for (std::size_t i = 0; i < n; i++) {
+            double axi = 0.0;
+            double ayi = 0.0;
+            for (std::size_t j = 0; j < n; j++) {
+                double dx = p.x[i] - p.x[j];
+                double dy = p.y[i] - p.y[j];
+                double r2 = dx * dx + dy * dy + eps2;
+                double s = (i == j) ? 0.0 : p.m[j] / r2;
+                axi -= s * dx;
+                ayi -= s * dy;
+            }
+            p.ax[i] = G * axi;
+            p.ay[i] = G * ayi;
+        }
+    }
+};
+
+// Kick-drift-kick leapfrog. Call prime() once so that ax/ay are valid before the first step; each step then costs a
+// single force evaluation.
+template <typename ForceEngine>
+struct LeapfrogIntegrator {
+    ForceEngine& engine;
+
+    void prime(ParticleSystem& p) { engine.compute_accelerations(p); }
+
+    void step(ParticleSystem& p, double dt) {
+        const std::size_t n = p.size();
+        const double half_dt = 0.5 * dt;
+        for (std::size_t i = 0; i < n; i++) {
+            p.vx[i] += half_dt * p.ax[i];
+            p.vy[i] += half_dt * p.ay[i];
+            p.x[i] += dt * p.vx[i];
+            p.y[i] += dt * p.vy[i];
+        }
+        engine.compute_accelerations(p);
+        for (std::size_t i = 0; i < n; i++) {
+            p.vx[i] += half_dt * p.ax[i];
+            p.vy[i] += half_dt * p.ay[i];
+        }
+    }
+};
@@ -0,0 +1,204 @@
+// PROJECTILE TRAJECTORY SOLVER
+// ARC PROJECTS - SIMULATION PROJECT 16-10-2026
+// Point-mass projectile in a vertical plane with
+//   - quadratic air drag, a = -k |v - w| (v - w), k = rho Cd A / (2 m), relative to a constant wind w
+//   - air density falling off exponentially with altitude, rho(y) = rho_0 exp(-y / H)
+//   - gravity falling off with altitude, g(y) = g_0 (R / (R + y))^2
+// There is no closed form once drag is included, so the equations of motion are integrated with classical RK4.
+//
+// Events (apex and ground impact) are not found by shrinking the step. Between two accepted steps the solution is
+// represented by a cubic Hermite interpolant built from the states and derivatives at both ends, which is accurate
+// to the same order as RK4; the event time is then the root of that interpolant, located with Brent's method
+// inside the bracket where the event function changed sign.
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "thread_pool.h"
+
+struct ProjectileParams {
+    double mass = 1.0;              // kg
+    double drag_coefficient = 0.47; // sphere
+    double area = 0.01;             // m^2
+    double air_density = 1.225;     // kg/m^3 at ground level
+    double scale_height = 8500.0;   // m
+    double wind_x = 0.0;            // m/s
+    double wind_y = 0.0;            // m/s
+    double g0 = 9.81;               // m/s^2
+    double planet_radius = 6.371e6; // m
+};
+
+struct ProjectileState {
+    double x = 0.0, y = 0.0, vx = 0.0, vy = 0.0;
+};
+
+struct TrajectoryResult {
+    double flight_time = 0.0;
+    double range = 0.0;
+    double impact_speed = 0.0;
+    double apex_time = 0.0;
+    double apex_height = 0.0;
+    int steps = 0;
+    bool landed = false;
+};
+
+// Brent's method on a bracket [a, b] with f(a), f(b) of opposite sign. Combines bisection with secant and inverse
+// quadratic interpolation, so it never does worse than bisection and usually converges superlinearly.
+template <typename Function>
+double brent_root(Function f, double a, double b, double fa, double fb, double tolerance = 1e-12, int max_iterations = 100) {
+    if (std::abs(fa) < std::abs(fb)) {
+        std::swap(a, b);
+        std::swap(fa, fb);
+    }
+    double c = a, fc = fa, d = b - a;
+    bool bisected = true;
+    for (int iteration = 0; iteration < max_iterations && fb != 0.0 && std::abs(b - a) > tolerance; iteration++) {
+        double s;
+        if (fa != fc && fb != fc) {
+            s = a * fb * fc / ((fa - fb) * (fa - fc)) + b * fa * fc / ((fb - fa) * (fb - fc)) + c * fa * fb / ((fc - fa) * (fc - fb));
+        }
+        else {
+            s = b - fb * (b - a) / (fb - fa);
+        }
+        double lower = (3.0 * a + b) / 4.0;
+        bool outside = (s - lower) * (s - b) > 0.0;
+        bool slow = bisected ? std::abs(s - b) >= std::abs(b - c) / 2.0 : std::abs(s - b) >= std::abs(c - d) / 2.0;
+        bool tiny = bisected ? std::abs(b - c) < tolerance : std::abs(c - d) < tolerance;
+        if (outside || slow || tiny) {
+            s = 0.5 * (a + b);
+            bisected = true;
+        }
+        else {
+            bisected = false;
+        }
+        double fs = f(s);
+        d = c;
+        c = b;
+        fc = fb;
+        if (fa * fs < 0.0) {
+            b = s;
+            fb = fs;
+        }
+        else {
+            a = s;
+            fa = fs;
+        }
+        if (std::abs(fa) < std::abs(fb)) {
+            std::swap(a, b);
+            std::swap(fa, fb);
+        }
+    }
+    return b;
+}
+
+class ProjectileSolver {
+public:
+    ProjectileParams params;
+    double dt = 0.05;         // s, fixed RK4 step
+    double max_time = 1000.0; // s
+
+    explicit ProjectileSolver(const ProjectileParams& p = {}) : params(p) {}
+
+    ProjectileState derivative(const ProjectileState& s) const {
+        double altitude = std::max(s.y, 0.0);
+        double rho = params.air_density * std::exp(-altitude / params.scale_height);
+        double k = 0.5 * rho * params.drag_coefficient * params.area / params.mass;
+        double rx = s.vx - params.wind_x;
+        double ry = s.vy - params.wind_y;
+        double speed = std::sqrt(rx * rx + ry * ry);
+        double ratio = params.planet_radius / (params.planet_radius + s.y);
+        double g = params.g0 * ratio * ratio;
+        return {s.vx, s.vy, -k * speed * rx, -k * speed * ry - g};
+    }
+
+    ProjectileState rk4_step(const ProjectileState& s, const ProjectileState& k1, double h) const {
+        ProjectileState k2 = derivative(advance(s, k1, 0.5 * h));
+        ProjectileState k3 = derivative(advance(s, k2, 0.5 * h));
+        ProjectileState k4 = derivative(advance(s, k3, h));
+        return {s.x + h / 6.0 * (k1.x + 2.0 * k2.x + 2.0 * k3.x + k4.x),
+                s.y + h / 6.0 * (k1.y + 2.0 * k2.y + 2.0 * k3.y + k4.y),
+                s.vx + h / 6.0 * (k1.vx + 2.0 * k2.vx + 2.0 * k3.vx + k4.vx),
+                s.vy + h / 6.0 * (k1.vy + 2.0 * k2.vy + 2.0 * k3.vy + k4.vy)};
+    }
+
+    // Launch from ground level at `speed` (m/s) and `angle` (rad above the horizontal).
+    TrajectoryResult solve(double speed, double angle) const {
+        TrajectoryResult result;
+        ProjectileState s = {0.0, 0.0, speed * std::cos(angle), speed * std::sin(angle)};
+        if (s.vy <= 0.0) {
+            // launched level or downwards from the ground: it is already at the impact point
+            result.impact_speed = speed;
+            result.landed = true;
+            return result;
+        }
+        ProjectileState ds = derivative(s);
+        bool apex_found = false;
+        double t = 0.0;
+        while (t < max_time) {
+            ProjectileState next = rk4_step(s, ds, dt);
+            ProjectileState dnext = derivative(next);
+            result.steps++;
+            // start of the impact bracket within this step; moved to the apex when a short hop rises and lands
+            // inside the launch step, where the step starts on the ground rather than above it
+            double impact_from = 0.0, impact_height = s.y;
+
+            // apex: vertical velocity changes sign from + to -
+            if (!apex_found && s.vy > 0.0 && next.vy <= 0.0) {
+                auto vy_at = [&](double tau) { return hermite(s.vy, ds.vy, next.vy, dnext.vy, tau); };
+                double tau = brent_root(vy_at, 0.0, dt, s.vy, next.vy);
+                result.apex_time = t + tau;
+                result.apex_height = hermite(s.y, ds.y, next.y, dnext.y, tau);
+                apex_found = true;
+                if (s.y <= 0.0) {
+                    impact_from = tau;
+                    impact_height = result.apex_height;
+                }
+            }
+
+            // impact: height goes from above the ground to on or below it
+            if (impact_height > 0.0 && next.y <= 0.0) {
+                auto y_at = [&](double tau) { return hermite(s.y, ds.y, next.y, dnext.y, tau); };
+                double tau = brent_root(y_at, impact_from, dt, impact_height, next.y);
+                double vx = hermite(s.vx, ds.vx, next.vx, dnext.vx, tau);
+                double vy = hermite(s.vy, ds.vy, next.vy, dnext.vy, tau);
+                result.flight_time = t + tau;
+                result.range = hermite(s.x, ds.x, next.x, dnext.x, tau);
+                result.impact_speed = std::sqrt(vx * vx + vy * vy);
+                result.landed = true;
+                return result;
+            }
+            s = next;
+            ds = dnext;
+            t += dt;
+        }
+        return result;
+    }
+
+    // Evaluates every (speed, angle) combination of the two grids across the thread pool. Results are stored
+    // row-major with the angle varying fastest.
+    void sweep(const std::vector<double>& speeds, const std::vector<double>& angles, ThreadPool& pool,
+               std::vector<TrajectoryResult>& results) const {
+        results.resize(speeds.size() * angles.size());
+        pool.parallel_for(0, results.size(), [&](std::size_t lo, std::size_t hi, unsigned) {
+            for (std::size_t k = lo; k < hi; k++) {
+                results[k] = solve(speeds[k / angles.size()], angles[k % angles.size()]);
+            }
+        });
+    }
+
+private:
+    ProjectileState advance(const ProjectileState& s, const ProjectileState& d, double h) const {
+        return {s.x + h * d.x, s.y + h * d.y, s.vx + h * d.vx, s.vy + h * d.vy};
+    }
+
+    // Cubic Hermite interpolant on [0, dt] from end values and end derivatives.
+    double hermite(double p0, double m0, double p1, double m1, double tau) const {
+        double u = tau / dt;
+        double u2 = u * u, u3 = u2 * u;
+        return (2.0 * u3 - 3.0 * u2 + 1.0) * p0 + (u3 - 2.0 * u2 + u) * dt * m0 + (-2.0 * u3 + 3.0 * u2) * p1
+             + (u3 - u2) * dt * m1;
+    }
+};
@@ -0,0 +1,680 @@
+// RIGID BODY ENGINE (2D)
+// ARC PROJECTS - SIMULATION PROJECT 16-10-2026
+// Bodies carry position, orientation and their inverse mass / inverse moment of inertia, so a static body is simply
+// one with both set to zero. Each step runs four phases:
+//   1. broad phase  - spatial hash grid, finds pairs whose bounding boxes overlap (multithreaded)
+//   2. narrow phase - exact circle/box tests producing contact manifolds of up to two points
+//   3. solver       - sequential impulses on normal and friction constraints, warm started from the previous frame
+//   4. integration  - semi-implicit (symplectic) Euler on linear and angular velocity
+//
+// Broad phase: every body is binned into the grid cell holding its centre. With the cell size at least the largest
+// body diameter, two overlapping bodies always sit in the same or adjacent cells, so each body only needs to look at
+// its own cell and four "forward" neighbours, which also means each pair is found exactly once.
+//
+// Solver: a resting contact needs the same impulse every frame, and ten iterations from zero do not find it in a tall
+// stack. Every contact point therefore carries a feature id (which faces and vertices produced it), and a point
+// found again next frame for the same pair and feature starts from last frame's accumulated normal and friction
+// impulses. Penetration beyond a small slop is removed by split impulses: a second set of iterations works on
+// pseudo-velocities that move the bodies this step and are then thrown away, so pushing bodies apart never adds
+// kinetic energy to the pile.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "thread_pool.h"
+
+struct Vec2 {
+    double x = 0.0, y = 0.0;
+};
+
+inline Vec2 operator+(Vec2 a, Vec2 b) { return {a.x + b.x, a.y + b.y}; }
+inline Vec2 operator-(Vec2 a, Vec2 b) { return {a.x - b.x, a.y - b.y}; }
+inline Vec2 operator-(Vec2 a) { return {-a.x, -a.y}; }
+inline Vec2 operator*(double s, Vec2 a) { return {s * a.x, s * a.y}; }
+inline double dot(Vec2 a, Vec2 b) { return a.x * b.x + a.y * b.y; }
+inline double cross(Vec2 a, Vec2 b) { return a.x * b.y - a.y * b.x; }
+inline Vec2 cross(double w, Vec2 r) { return {-w * r.y, w * r.x}; }  // w x r for a scalar angular velocity
+inline Vec2 rotate(Vec2 v, double c, double s) { return {c * v.x - s * v.y, s * v.x + c * v.y}; }
+
+enum class Shape { Circle, Box };
+
+struct RigidBody {
+    Vec2 position;
+    double angle = 0.0;
+    Vec2 velocity;
+    double angular_velocity = 0.0;
+    double inv_mass = 0.0;
+    double inv_inertia = 0.0;
+    double friction = 0.5;
+    double rolling_resistance = 0.0;  // circles: the rolling torque's lever arm as a fraction of the radius
+    Shape shape = Shape::Box;
+    Vec2 half_extents;   // boxes
+    double radius = 0.0; // circles; for boxes the bounding radius
+
+    static RigidBody box(Vec2 position, Vec2 half_extents, double density) {
+        RigidBody b;
+        b.position = position;
+        b.shape = Shape::Box;
+        b.half_extents = half_extents;
+        b.radius = std::sqrt(dot(half_extents, half_extents));
+        double mass = density * 4.0 * half_extents.x * half_extents.y;
+        if (mass > 0.0) {
+            double inertia = mass * (4.0 * dot(half_extents, half_extents)) / 12.0;
+            b.inv_mass = 1.0 / mass;
+            b.inv_inertia = 1.0 / inertia;
+        }
+        return b;
+    }
+
+    static RigidBody circle(Vec2 position, double radius, double density) {
+        RigidBody b;
+        b.position = position;
+        b.shape = Shape::Circle;
+        b.radius = radius;
+        double mass = density * 3.14159265358979323846 * radius * radius;
+        if (mass > 0.0) {
+            b.inv_mass = 1.0 / mass;
+            b.inv_inertia = 1.0 / (0.5 * mass * radius * radius);
+        }
+        return b;
+    }
+};
+
+struct BodyPair {
+    std::uint32_t a, b;
+};
+
+struct ContactPoint {
+    Vec2 position;
+    double penetration = 0.0;
+    std::uint32_t feature = 0;  // identifies the point within its manifold across frames
+    double normal_impulse = 0.0;
+    double tangent_impulse = 0.0;
+    double bias_impulse = 0.0;  // split impulse, moves positions only
+    double normal_mass = 0.0;
+    double tangent_mass = 0.0;
+    double bias = 0.0;
+};
+
+struct Manifold {
+    std::uint32_t a, b;
+    Vec2 normal;  // points from a to b
+    int count = 0;
+    ContactPoint points[2];
+    double rolling_impulse = 0.0;  // angular impulse resisting rolling, when a circle is involved
+};
+
+// ---------------------------------------------------------------------------------------------------------------
+// Broad phase
+
+class SpatialHashGrid {
+public:
+    // Finds every pair of bodies with overlapping bounding boxes. Pairs are returned in a deterministic order
+    // regardless of the number of threads.
+    void find_pairs(const std::vector<RigidBody>& bodies, ThreadPool& pool, std::vector<BodyPair>& pairs) {
+        const std::size_t n = bodies.size();
+        pairs.clear();
+        if (n < 2) {
+            return;
+        }
+
+        double largest = 0.0;
+        bool any_dynamic = false;
+        for (const RigidBody& b : bodies) {
+            if (b.inv_mass > 0.0) {
+                largest = std::max(largest, b.radius);
+                any_dynamic = true;
+            }
+        }
+        if (!any_dynamic) {
+            return;  // static pairs are never reported, so there is nothing to find
+        }
+        if (largest == 0.0) {
+            largest = 0.5;  // only point masses, which overlap only where they coincide: any cell size will do
+        }
+        const double inv_cell = 1.0 / (2.0 * largest);
+
+        // cells are numbered row-major over the occupied region when that region is compact, which keeps
+        // neighbouring cells close in memory; sparse scenes fall back to hashing the cell coordinates
+        double lo_x = 1e300, lo_y = 1e300, hi_x = -1e300, hi_y = -1e300;
+        for (const RigidBody& b : bodies) {
+            if (b.radius <= largest) {
+                lo_x = std::min(lo_x, b.position.x); hi_x = std::max(hi_x, b.position.x);
+                lo_y = std::min(lo_y, b.position.y); hi_y = std::max(hi_y, b.position.y);
+            }
+        }
+        origin_x = static_cast<std::int32_t>(std::floor(lo_x * inv_cell));
+        origin_y = static_cast<std::int32_t>(std::floor(lo_y * inv_cell));
+        grid_x = static_cast<std::int32_t>(std::floor(hi_x * inv_cell)) - origin_x + 1;
+        grid_y = static_cast<std::int32_t>(std::floor(hi_y * inv_cell)) - origin_y + 1;
+        std::size_t buckets;
+        dense = static_cast<double>(grid_x) * grid_y <= 4.0 * n;
+        if (dense) {
+            buckets = static_cast<std::size_t>(grid_x) * grid_y;
+        }
+        else {
+            buckets = 1;
+            while (buckets < 2 * n) {
+                buckets <<= 1;
+            }
+            mask = buckets - 1;
+        }
+
+        // bounding boxes and cells for every body (parallel); large static bodies such as the ground do not fit the
+        // grid and are kept aside to be tested against everything
+        bounds.resize(n);
+        bucket_of.resize(n);
+        pool.parallel_for(0, n, [&](std::size_t lo, std::size_t hi, unsigned) {
+            for (std::size_t i = lo; i < hi; i++) {
+                const RigidBody& b = bodies[i];
+                double hx = b.radius, hy = b.radius;
+                if (b.shape == Shape::Box) {
+                    double c = std::abs(std::cos(b.angle)), s = std::abs(std::sin(b.angle));
+                    hx = c * b.half_extents.x + s * b.half_extents.y;
+                    hy = s * b.half_extents.x + c * b.half_extents.y;
+                }
+                Bounds& e = bounds[i];
+                e.min_x = b.position.x - hx; e.max_x = b.position.x + hx;
+                e.min_y = b.position.y - hy; e.max_y = b.position.y + hy;
+                e.cell_x = static_cast<std::int32_t>(std::floor(b.position.x * inv_cell));
+                e.cell_y = static_cast<std::int32_t>(std::floor(b.position.y * inv_cell));
+                e.id = static_cast<std::uint32_t>(i);
+                e.dynamic = b.inv_mass > 0.0;
+                bucket_of[i] = (b.radius > largest) ? static_cast<std::uint32_t>(buckets)
+                                                    : static_cast<std::uint32_t>(cell_key(e.cell_x, e.cell_y));
+            }
+        });
+
+        // counting sort into buckets; bodies in the same cell become contiguous, so the pair search reads a compact
+        // array instead of chasing body indices around memory
+        bucket_start.assign(buckets + 2, 0);
+        for (std::size_t i = 0; i < n; i++) {
+            bucket_start[bucket_of[i] + 1]++;
+        }
+        for (std::size_t k = 0; k <= buckets; k++) {
+            bucket_start[k + 1] += bucket_start[k];
+        }
+        sorted.resize(n);
+        std::vector<std::uint32_t> fill(bucket_start.begin(), bucket_start.end() - 1);
+        for (std::size_t i = 0; i < n; i++) {
+            sorted[fill[bucket_of[i]]++] = bounds[i];
+        }
+        const std::size_t in_grid = bucket_start[buckets];
+
+        // pair search (parallel), one pair list per worker, concatenated in worker order
+        thread_pairs.resize(pool.size());
+        for (std::vector<BodyPair>& list : thread_pairs) {
+            list.clear();
+        }
+        pool.parallel_for(0, in_grid, [&](std::size_t lo, std::size_t hi, unsigned worker) {
+            std::vector<BodyPair>& out = thread_pairs[worker];
+            static const int forward[5][2] = {{0, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+            for (std::size_t i = lo; i < hi; i++) {
+                const Bounds& bi = sorted[i];
+                for (const auto& offset : forward) {
+                    std::int32_t cx = bi.cell_x + offset[0];
+                    std::int32_t cy = bi.cell_y + offset[1];
+                    if (dense && (cx - origin_x >= grid_x || cx < origin_x || cy - origin_y >= grid_y)) {
+                        continue;
+                    }
+                    std::size_t k = cell_key(cx, cy);
+                    // within its own cell a body only pairs with later slots, so each pair is reported once
+                    std::size_t first = (offset[0] == 0 && offset[1] == 0) ? i + 1 : bucket_start[k];
+                    for (std::size_t j = first; j < bucket_start[k + 1]; j++) {
+                        const Bounds& bj = sorted[j];
+                        // hashed buckets may hold several cells
+                        if (bj.cell_x != cx || bj.cell_y != cy || !(bi.dynamic || bj.dynamic)) {
+                            continue;
+                        }
+                        if (overlap(bi, bj)) {
+                            out.push_back({bi.id, bj.id});
+                        }
+                    }
+                }
+                for (std::size_t j = in_grid; j < n; j++) {
+                    if (bi.dynamic && overlap(bi, sorted[j])) {
+                        out.push_back({bi.id, sorted[j].id});
+                    }
+                }
+            }
+        });
+        for (const std::vector<BodyPair>& list : thread_pairs) {
+            pairs.insert(pairs.end(), list.begin(), list.end());
+        }
+    }
+
+private:
+    struct Bounds {
+        double min_x, min_y, max_x, max_y;
+        std::int32_t cell_x, cell_y;
+        std::uint32_t id;
+        bool dynamic;
+    };
+
+    bool dense = false;
+    std::int32_t origin_x = 0, origin_y = 0, grid_x = 0, grid_y = 0;
+    std::size_t mask = 0;
+    std::vector<Bounds> bounds, sorted;
+    std::vector<std::uint32_t> bucket_of, bucket_start;
+    std::vector<std::vector<BodyPair>> thread_pairs;
+
+    std::size_t cell_key(std::int32_t x, std::int32_t y) const {
+        if (dense) {
+            return static_cast<std::size_t>(y - origin_y) * grid_x + (x - origin_x);
+        }
+        std::uint64_t h = static_cast<std::uint32_t>(x) * 0x9E3779B97F4A7C15ull ^ static_cast<std::uint32_t>(y) * 0xC2B2AE3D27D4EB4Full;
+        return static_cast<std::size_t>(h ^ (h >> 29)) & mask;
+    }
+
+    static bool overlap(const Bounds& a, const Bounds& b) {
+        return a.min_x <= b.max_x && b.min_x <= a.max_x && a.min_y <= b.max_y && b.min_y <= a.max_y;
+    }
+};
+
+// ---------------------------------------------------------------------------------------------------------------
+// Narrow phase
+
+inline bool collide_circles(const RigidBody& a, const RigidBody& b, Manifold& m) {
+    Vec2 d = b.position - a.position;
+    double dist2 = dot(d, d);
+    double r = a.radius + b.radius;
+    if (dist2 >= r * r) {
+        return false;
+    }
+    double dist = std::sqrt(dist2);
+    m.normal = (dist > 1e-12) ? (1.0 / dist) * d : Vec2{0.0, 1.0};
+    m.count = 1;
+    m.points[0] = {};
+    m.points[0].position = a.position + (a.radius - 0.5 * (r - dist)) * m.normal;
+    m.points[0].penetration = r - dist;
+    return true;
+}
+
+// Box a against circle b; the normal points from the box to the circle.
+inline bool collide_box_circle(const RigidBody& a, const RigidBody& b, Manifold& m) {
+    double c = std::cos(a.angle), s = std::sin(a.angle);
+    Vec2 local = rotate(b.position - a.position, c, -s);
+    Vec2 h = a.half_extents;
+    Vec2 closest = {std::clamp(local.x, -h.x, h.x), std::clamp(local.y, -h.y, h.y)};
+    Vec2 normal_local;
+    double penetration;
+    if (closest.x == local.x && closest.y == local.y) {
+        // centre inside the box: push out through the nearest face
+        double dx = h.x - std::abs(local.x);
+        double dy = h.y - std::abs(local.y);
+        if (dx < dy) {
+            normal_local = {local.x < 0 ? -1.0 : 1.0, 0.0};
+            closest.x = normal_local.x * h.x;
+            penetration = dx + b.radius;
+        }
+        else {
+            normal_local = {0.0, local.y < 0 ? -1.0 : 1.0};
+            closest.y = normal_local.y * h.y;
+            penetration = dy + b.radius;
+        }
+    }
+    else {
+        Vec2 d = local - closest;
+        double dist = std::sqrt(dot(d, d));
+        if (dist >= b.radius) {
+            return false;
+        }
+        normal_local = (1.0 / dist) * d;
+        penetration = b.radius - dist;
+    }
+    m.normal = rotate(normal_local, c, s);
+    m.count = 1;
+    m.points[0] = {};
+    m.points[0].position = a.position + rotate(closest, c, s);
+    m.points[0].penetration = penetration;
+    return true;
+}
+
+// Separating axis test over the four face normals, then clipping of the incident edge against the reference face.
+inline bool collide_boxes(const RigidBody& a, const RigidBody& b, Manifold& m) {
+    const RigidBody* box[2] = {&a, &b};
+    Vec2 axis[2][2];
+    for (int k = 0; k < 2; k++) {
+        double c = std::cos(box[k]->angle), s = std::sin(box[k]->angle);
+        axis[k][0] = {c, s};
+        axis[k][1] = {-s, c};
+    }
+    Vec2 d = b.position - a.position;
+
+    // deepest separation along the face normals of each box; any positive separation is a separating axis
+    double separation[2] = {-1e300, -1e300};
+    int face[2] = {0, 0};
+    Vec2 face_normal[2];
+    for (int k = 0; k < 2; k++) {
+        const RigidBody& self = *box[k];
+        const RigidBody& other = *box[1 - k];
+        Vec2 towards = (k == 0) ? d : -d;
+        for (int j = 0; j < 2; j++) {
+            Vec2 n = axis[k][j];
+            double h_self = (j == 0) ? self.half_extents.x : self.half_extents.y;
+            double h_other = other.half_extents.x * std::abs(dot(n, axis[1 - k][0]))
+                           + other.half_extents.y * std::abs(dot(n, axis[1 - k][1]));
+            double sep = std::abs(dot(towards, n)) - h_self - h_other;
+            if (sep > 0.0) {
+                return false;
+            }
+            if (sep > separation[k]) {
+                separation[k] = sep;
+                face[k] = j;
+                // outward normal of the face looking at the other box
+                face_normal[k] = (dot(towards, n) >= 0.0) ? n : -n;
+            }
+        }
+    }
+
+    // prefer box a as the reference unless b is clearly shallower, which keeps the manifold stable between frames
+    int ref = (separation[1] > 0.95 * separation[0] + 0.01 * a.radius) ? 1 : 0;
+    int ref_axis = face[ref];
+    Vec2 best_normal = face_normal[ref];
+    bool ref_flipped = dot(best_normal, axis[ref][ref_axis]) < 0.0;
+
+    const RigidBody& rb = *box[ref];
+    const RigidBody& ib = *box[1 - ref];
+    Vec2 n = best_normal;
+    Vec2 t = {-n.y, n.x};
+    double h_n = (ref_axis == 0) ? rb.half_extents.x : rb.half_extents.y;
+    double h_t = (ref_axis == 0) ? rb.half_extents.y : rb.half_extents.x;
+    Vec2 face_centre = rb.position + h_n * n;
+
+    // incident face: the face of the other box most anti-parallel to n
+    int inc_axis = (std::abs(dot(n, axis[1 - ref][0])) > std::abs(dot(n, axis[1 - ref][1]))) ? 0 : 1;
+    Vec2 inc_n = axis[1 - ref][inc_axis];
+    bool inc_flipped = dot(inc_n, n) > 0.0;
+    if (inc_flipped) {
+        inc_n = -inc_n;
+    }
+    Vec2 inc_t = {-inc_n.y, inc_n.x};
+    double inc_hn = (inc_axis == 0) ? ib.half_extents.x : ib.half_extents.y;
+    double inc_ht = (inc_axis == 0) ? ib.half_extents.y : ib.half_extents.x;
+    Vec2 inc_centre = ib.position + inc_hn * inc_n;
+    Vec2 v[2] = {inc_centre + inc_ht * inc_t, inc_centre - inc_ht * inc_t};
+
+    // clip the incident edge to the side planes of the reference face, remembering which plane cut each end
+    double u[2] = {dot(v[0] - face_centre, t), dot(v[1] - face_centre, t)};
+    std::uint32_t clipped_by[2] = {0, 0};
+    for (int side = 0; side < 2; side++) {
+        double sign = side == 0 ? 1.0 : -1.0;
+        double d0 = sign * u[0] - h_t;
+        double d1 = sign * u[1] - h_t;
+        if (d0 > 0.0 && d1 > 0.0) {
+            return false;
+        }
+        if (d0 > 0.0 || d1 > 0.0) {
+            double f = d0 / (d0 - d1);
+            Vec2 clipped = v[0] + f * (v[1] - v[0]);
+            double uc = u[0] + f * (u[1] - u[0]);
+            int end = (d0 > 0.0) ? 0 : 1;
+            v[end] = clipped;
+            u[end] = uc;
+            clipped_by[end] = static_cast<std::uint32_t>(side + 1);
+        }
+    }
+
+    // feature id: reference box and face, incident face, which end of the incident edge and the plane that clipped it
+    const std::uint32_t faces = static_cast<std::uint32_t>(ref) | static_cast<std::uint32_t>(ref_axis) << 1
+                              | static_cast<std::uint32_t>(ref_flipped) << 2 | static_cast<std::uint32_t>(inc_axis) << 3
+                              | static_cast<std::uint32_t>(inc_flipped) << 4;
+    m.count = 0;
+    for (int k = 0; k < 2; k++) {
+        double separation = dot(v[k] - face_centre, n);
+        if (separation <= 0.0) {
+            ContactPoint& p = m.points[m.count++];
+            p = {};
+            p.position = v[k] - (0.5 * separation) * n;
+            p.penetration = -separation;
+            p.feature = faces | static_cast<std::uint32_t>(k) << 5 | clipped_by[k] << 6;
+        }
+    }
+    m.normal = (ref == 0) ? n : -n;
+    return m.count > 0;
+}
+
+// The manifold's bodies are in a fixed order (box first, otherwise the lower index), whichever order the broad
+// phase reported them in, so a pair keeps the same normal direction and feature ids from frame to frame.
+inline bool collide(const std::vector<RigidBody>& bodies, BodyPair pair, Manifold& m) {
+    m.a = std::min(pair.a, pair.b);
+    m.b = std::max(pair.a, pair.b);
+    const RigidBody& a = bodies[m.a];
+    const RigidBody& b = bodies[m.b];
+    if (a.shape == Shape::Box && b.shape == Shape::Box) {
+        return collide_boxes(a, b, m);
+    }
+    if (a.shape == Shape::Circle && b.shape == Shape::Circle) {
+        return collide_circles(a, b, m);
+    }
+    if (a.shape == Shape::Box) {
+        return collide_box_circle(a, b, m);
+    }
+    std::swap(m.a, m.b);
+    return collide_box_circle(b, a, m);
+}
+
+// ---------------------------------------------------------------------------------------------------------------
+// World
+
+struct StepTimings {
+    double broad = 0.0, narrow = 0.0, solve = 0.0;
+};
+
+class RigidBodyWorld {
+public:
+    std::vector<RigidBody> bodies;
+    Vec2 gravity = {0.0, -9.81};
+    int solver_iterations = 10;
+    double baumgarte = 0.2;      // fraction of the penetration corrected per step
+    double allowed_penetration = 0.01;
+    bool warm_starting = true;
+
+    explicit RigidBodyWorld(unsigned threads = std::max(1u, std::thread::hardware_concurrency())) : pool(threads) {}
+
+    const std::vector<Manifold>& contacts() const { return manifolds; }
+    std::size_t pair_count() const { return pairs.size(); }
+
+    void find_pairs() { broad_phase.find_pairs(bodies, pool, pairs); }
+
+    void step(double dt, StepTimings* timings = nullptr) {
+        using clock = std::chrono::steady_clock;
+        auto t0 = clock::now();
+        find_pairs();
+        auto t1 = clock::now();
+
+        // last frame's manifolds, sorted by pair so the narrow phase can look up each new manifold's predecessor
+        previous.swap(manifolds);
+        std::sort(previous.begin(), previous.end(), [](const Manifold& x, const Manifold& y) {
+            return x.a != y.a ? x.a < y.a : x.b < y.b;
+        });
+
+        // narrow phase in parallel; each worker fills its own list, merged in worker order
+        thread_manifolds.resize(pool.size());
+        for (std::vector<Manifold>& list : thread_manifolds) {
+            list.clear();
+        }
+        pool.parallel_for(0, pairs.size(), [&](std::size_t lo, std::size_t hi, unsigned worker) {
+            Manifold m;
+            for (std::size_t k = lo; k < hi; k++) {
+                if (collide(bodies, pairs[k], m)) {
+                    if (warm_starting) {
+                        carry_impulses(m);
+                    }
+                    thread_manifolds[worker].push_back(m);
+                }
+            }
+        });
+        manifolds.clear();
+        for (const std::vector<Manifold>& list : thread_manifolds) {
+            manifolds.insert(manifolds.end(), list.begin(), list.end());
+        }
+        auto t2 = clock::now();
+
+        for (RigidBody& b : bodies) {
+            if (b.inv_mass > 0.0) {
+                b.velocity = b.velocity + dt * gravity;
+            }
+        }
+        prepare_contacts(dt);
+        for (int iteration = 0; iteration < solver_iterations; iteration++) {
+            for (Manifold& m : manifolds) {
+                solve_manifold(m);
+            }
+        }
+        for (int iteration = 0; iteration < solver_iterations; iteration++) {
+            for (Manifold& m : manifolds) {
+                solve_penetration(m);
+            }
+        }
+        for (std::size_t i = 0; i < bodies.size(); i++) {
+            RigidBody& b = bodies[i];
+            b.position = b.position + dt * (b.velocity + bias_velocity[i]);
+            b.angle += dt * (b.angular_velocity + bias_angular_velocity[i]);
+        }
+        auto t3 = clock::now();
+
+        if (timings) {
+            timings->broad += std::chrono::duration<double>(t1 - t0).count();
+            timings->narrow += std::chrono::duration<double>(t2 - t1).count();
+            timings->solve += std::chrono::duration<double>(t3 - t2).count();
+        }
+    }
+
+private:
+    ThreadPool pool;
+    SpatialHashGrid broad_phase;
+    std::vector<BodyPair> pairs;
+    std::vector<Manifold> manifolds, previous;
+    std::vector<std::vector<Manifold>> thread_manifolds;
+    std::vector<Vec2> bias_velocity;  // split-impulse pseudo-velocities, cleared every step
+    std::vector<double> bias_angular_velocity;
+
+    // Copies the accumulated impulses of every point that last frame's manifold for the same pair also had.
+    void carry_impulses(Manifold& m) const {
+        auto it = std::lower_bound(previous.begin(), previous.end(), m, [](const Manifold& x, const Manifold& y) {
+            return x.a != y.a ? x.a < y.a : x.b < y.b;
+        });
+        if (it == previous.end() || it->a != m.a || it->b != m.b) {
+            return;
+        }
+        m.rolling_impulse = it->rolling_impulse;
+        for (int k = 0; k < m.count; k++) {
+            for (int j = 0; j < it->count; j++) {
+                if (it->points[j].feature == m.points[k].feature) {
+                    m.points[k].normal_impulse = it->points[j].normal_impulse;
+                    m.points[k].tangent_impulse = it->points[j].tangent_impulse;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Effective masses and penetration targets for every point, then the warm start: the impulses carried over from
+    // last frame are applied once up front, so the iterations only have to correct them.
+    void prepare_contacts(double dt) {
+        bias_velocity.assign(bodies.size(), Vec2{});
+        bias_angular_velocity.assign(bodies.size(), 0.0);
+        for (Manifold& m : manifolds) {
+            RigidBody& a = bodies[m.a];
+            RigidBody& b = bodies[m.b];
+            Vec2 t = {-m.normal.y, m.normal.x};
+            for (int k = 0; k < m.count; k++) {
+                ContactPoint& p = m.points[k];
+                Vec2 ra = p.position - a.position;
+                Vec2 rb = p.position - b.position;
+                double rna = cross(ra, m.normal), rnb = cross(rb, m.normal);
+                double rta = cross(ra, t), rtb = cross(rb, t);
+                p.normal_mass = 1.0 / (a.inv_mass + b.inv_mass + a.inv_inertia * rna * rna + b.inv_inertia * rnb * rnb);
+                p.tangent_mass = 1.0 / (a.inv_mass + b.inv_mass + a.inv_inertia * rta * rta + b.inv_inertia * rtb * rtb);
+                p.bias = baumgarte / dt * std::max(0.0, p.penetration - allowed_penetration);
+                apply_impulse(a, b, ra, rb, p.normal_impulse * m.normal + p.tangent_impulse * t);
+            }
+            a.angular_velocity -= a.inv_inertia * m.rolling_impulse;
+            b.angular_velocity += b.inv_inertia * m.rolling_impulse;
+        }
+    }
+
+    static double rolling_arm(const RigidBody& b) {
+        return (b.shape == Shape::Circle) ? b.rolling_resistance * b.radius : 0.0;
+    }
+
+    void apply_impulse(RigidBody& a, RigidBody& b, Vec2 ra, Vec2 rb, Vec2 impulse) {
+        a.velocity = a.velocity - a.inv_mass * impulse;
+        a.angular_velocity -= a.inv_inertia * cross(ra, impulse);
+        b.velocity = b.velocity + b.inv_mass * impulse;
+        b.angular_velocity += b.inv_inertia * cross(rb, impulse);
+    }
+
+    void solve_manifold(Manifold& m) {
+        RigidBody& a = bodies[m.a];
+        RigidBody& b = bodies[m.b];
+        Vec2 n = m.normal;
+        Vec2 t = {-n.y, n.x};
+        double mu = std::sqrt(a.friction * b.friction);
+        for (int k = 0; k < m.count; k++) {
+            ContactPoint& p = m.points[k];
+            Vec2 ra = p.position - a.position;
+            Vec2 rb = p.position - b.position;
+
+            // normal impulse, accumulated and clamped to stay non-negative
+            Vec2 dv = b.velocity + cross(b.angular_velocity, rb) - a.velocity - cross(a.angular_velocity, ra);
+            double lambda = -p.normal_mass * dot(dv, n);
+            double previous = p.normal_impulse;
+            p.normal_impulse = std::max(previous + lambda, 0.0);
+            apply_impulse(a, b, ra, rb, (p.normal_impulse - previous) * n);
+
+            // friction impulse, bounded by the Coulomb cone
+            dv = b.velocity + cross(b.angular_velocity, rb) - a.velocity - cross(a.angular_velocity, ra);
+            lambda = -p.tangent_mass * dot(dv, t);
+            double limit = mu * p.normal_impulse;
+            previous = p.tangent_impulse;
+            p.tangent_impulse = std::clamp(previous + lambda, -limit, limit);
+            apply_impulse(a, b, ra, rb, (p.tangent_impulse - previous) * t);
+        }
+
+        // rolling resistance: an angular impulse against the relative spin, bounded like friction by the normal load
+        double arm = std::max(rolling_arm(a), rolling_arm(b));
+        if (arm > 0.0 && a.inv_inertia + b.inv_inertia > 0.0) {
+            double load = 0.0;
+            for (int k = 0; k < m.count; k++) {
+                load += m.points[k].normal_impulse;
+            }
+            double lambda = -(b.angular_velocity - a.angular_velocity) / (a.inv_inertia + b.inv_inertia);
+            double previous = m.rolling_impulse;
+            m.rolling_impulse = std::clamp(previous + lambda, -arm * load, arm * load);
+            a.angular_velocity -= a.inv_inertia * (m.rolling_impulse - previous);
+            b.angular_velocity += b.inv_inertia * (m.rolling_impulse - previous);
+        }
+    }
+
+    // Split impulse: pushes penetrating points apart through the pseudo-velocities, which only move the bodies.
+    void solve_penetration(Manifold& m) {
+        const RigidBody& a = bodies[m.a];
+        const RigidBody& b = bodies[m.b];
+        Vec2& va = bias_velocity[m.a];
+        Vec2& vb = bias_velocity[m.b];
+        double& wa = bias_angular_velocity[m.a];
+        double& wb = bias_angular_velocity[m.b];
+        Vec2 n = m.normal;
+        for (int k = 0; k < m.count; k++) {
+            ContactPoint& p = m.points[k];
+            Vec2 ra = p.position - a.position;
+            Vec2 rb = p.position - b.position;
+            Vec2 dv = vb + cross(wb, rb) - va - cross(wa, ra);
+            double lambda = p.normal_mass * (p.bias - dot(dv, n));
+            double previous = p.bias_impulse;
+            p.bias_impulse = std::max(previous + lambda, 0.0);
+            Vec2 impulse = (p.bias_impulse - previous) * n;
+            va = va - a.inv_mass * impulse;
+            wa -= a.inv_inertia * cross(ra, impulse);
+            vb = vb + b.inv_mass * impulse;
+            wb += b.inv_inertia * cross(rb, impulse);
+        }
+    }
+};
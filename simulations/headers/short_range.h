@@ -0,0 +1,276 @@
+// SHORT-RANGE FORCE ENGINE - CELL LISTS AND VERLET NEIGHBOUR LISTS
+// ARC PROJECTS - SIMULATION PROJECT 16-10-2026
+// Force engine for potentials that vanish beyond a cutoff rc (Lennard-Jones, soft spheres), in a periodic square
+// box. Plugs into LeapfrogIntegrator from particle_system.h like the gravity engines.
+//
+// Two levels of bookkeeping keep the cost O(N) per step:
+//   cell list      - particles are binned into cells of side >= rc + skin, so candidate neighbours only come from
+//                    the 3 x 3 block of cells around a particle. A box narrower than three cells cannot be binned
+//                    that way (the block would wrap onto itself), so there every pair is checked instead
+//   neighbour list - from those candidates, every pair closer than rc + skin is stored. While no particle has moved
+//                    more than skin / 2 since the list was built, no pair can have come within rc unnoticed, so the
+//                    list is reused and the cell binning is skipped entirely
+// The list is stored in compressed sparse row form: offsets[i] .. offsets[i + 1] index into one flat array of
+// neighbour ids. Each particle keeps a full list (both i-j and j-i), so the force loop only writes to particle i and
+// its inner loop has no scattered stores, which lets the compiler vectorise it.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "deterministic_reduce.h"
+#include "particle_system.h"
+#include "thread_pool.h"
+
+// U(r) = 4 eps ((sigma / r)^12 - (sigma / r)^6), truncated at the cutoff
+struct LennardJones {
+    double epsilon = 1.0;
+    double sigma = 1.0;
+    double cutoff = 2.5;
+
+    // force magnitude divided by r, and the pair energy, for a squared distance r2 < cutoff^2
+    double force_over_r(double r2) const {
+        double s2 = sigma * sigma / r2;
+        double s6 = s2 * s2 * s2;
+        return 24.0 * epsilon * s6 * (2.0 * s6 - 1.0) / r2;
+    }
+    double energy(double r2) const {
+        double s2 = sigma * sigma / r2;
+        double s6 = s2 * s2 * s2;
+        return 4.0 * epsilon * s6 * (s6 - 1.0);
+    }
+};
+
+// U(r) = eps (1 - r / sigma)^2 for r < sigma, a purely repulsive soft contact
+struct SoftSphere {
+    double epsilon = 1.0;
+    double sigma = 1.0;
+    double cutoff = 1.0;
+
+    double force_over_r(double r2) const {
+        double r = std::sqrt(r2);
+        return 2.0 * epsilon * (1.0 - r / sigma) / (sigma * r);
+    }
+    double energy(double r2) const {
+        double d = 1.0 - std::sqrt(r2) / sigma;
+        return epsilon * d * d;
+    }
+};
+
+template <typename Potential>
+class ShortRangeEngine {
+public:
+    Potential potential;
+    double box = 1.0;   // periodic box side, more than twice cutoff + skin for the minimum image to hold
+    double skin = 0.3;
+    bool deterministic = false;  // reduce the potential energy in a fixed order, identical for any thread count
+
+    ShortRangeEngine(Potential potential, double box, ThreadPool& pool) : potential(potential), box(box), pool(pool) {}
+
+    std::size_t rebuilds() const { return rebuild_count; }
+    std::size_t pair_entries() const { return neighbours.size(); }
+    double potential_energy() const { return last_energy; }
+
+    void compute_accelerations(ParticleSystem& p) {
+        if (needs_rebuild(p)) {
+            build(p);
+        }
+        const double rc2 = potential.cutoff * potential.cutoff;
+        const double inv_box = 1.0 / box;
+        // shift the pair energy to zero at the cutoff so that pairs crossing it do not make the energy jump
+        const double shift = potential.energy(rc2);
+        energy_parts.assign(pool.size(), 0.0);
+        particle_energy.resize(deterministic ? p.size() : 0);
+        pool.parallel_for(0, p.size(), [&](std::size_t lo, std::size_t hi, unsigned worker) {
+            double energy = 0.0;
+            for (std::size_t i = lo; i < hi; i++) {
+                const double xi = p.x[i], yi = p.y[i];
+                double fx = 0.0, fy = 0.0;
+                double ei = 0.0;
+                for (std::uint32_t k = offsets[i]; k < offsets[i + 1]; k++) {
+                    std::uint32_t j = neighbours[k];
+                    double dx = xi - p.x[j];
+                    double dy = yi - p.y[j];
+                    // minimum image, written without branches
+                    dx -= box * std::floor(dx * inv_box + 0.5);
+                    dy -= box * std::floor(dy * inv_box + 0.5);
+                    double r2 = dx * dx + dy * dy;
+                    double inside = (r2 < rc2) ? 1.0 : 0.0;
+                    double safe_r2 = (r2 < rc2) ? r2 : rc2;
+                    double f = inside * potential.force_over_r(safe_r2);
+                    fx += f * dx;
+                    fy += f * dy;
+                    ei += 0.5 * inside * (potential.energy(safe_r2) - shift);
+                }
+                if (deterministic) {
+                    particle_energy[i] = ei;
+                }
+                energy += ei;
+                p.ax[i] = fx / p.m[i];
+                p.ay[i] = fy / p.m[i];
+            }
+            energy_parts[worker] += energy;
+        });
+        if (deterministic) {
+            last_energy = deterministic_sum(pool, p.size(), [&](std::size_t i) { return particle_energy[i]; });
+            return;
+        }
+        last_energy = 0.0;
+        for (double e : energy_parts) {
+            last_energy += e;
+        }
+    }
+
+private:
+    ThreadPool& pool;
+    std::vector<std::uint32_t> offsets, neighbours;
+    std::vector<double> built_x, built_y;  // positions when the list was built
+    std::vector<std::uint32_t> cell_start, cell_particles;
+    std::vector<double> cell_x, cell_y;  // positions in cell order, so candidate scans read contiguous memory
+    std::vector<std::vector<std::uint32_t>> thread_lists;
+    std::vector<std::uint32_t> thread_counts;
+    std::vector<double> energy_parts;
+    std::vector<double> particle_energy;  // only filled in deterministic mode
+    std::size_t rebuild_count = 0;
+    double last_energy = 0.0;
+
+    bool needs_rebuild(const ParticleSystem& p) const {
+        if (built_x.size() != p.size()) {
+            return true;
+        }
+        const double limit2 = 0.25 * skin * skin;
+        for (std::size_t i = 0; i < p.size(); i++) {
+            double dx = p.x[i] - built_x[i];
+            double dy = p.y[i] - built_y[i];
+            if (dx * dx + dy * dy > limit2) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void build(ParticleSystem& p) {
+        const std::size_t n = p.size();
+        rebuild_count++;
+
+        // wrap everyone back into the box; displacements are tracked from here
+        for (std::size_t i = 0; i < n; i++) {
+            p.x[i] -= box * std::floor(p.x[i] / box);
+            p.y[i] -= box * std::floor(p.y[i] / box);
+        }
+        built_x = p.x;
+        built_y = p.y;
+
+        // every worker's list is cleared up front: a worker that gets no range this step (n below the pool size)
+        // must not contribute last step's entries
+        const double reach = potential.cutoff + skin;
+        const int cells = static_cast<int>(box / reach);
+        thread_lists.resize(pool.size());
+        for (std::vector<std::uint32_t>& list : thread_lists) {
+            list.clear();
+        }
+        thread_counts.assign(n, 0);
+        if (cells >= 3) {
+            search_cells(p, cells, reach * reach);
+        }
+        else {
+            search_all_pairs(p, reach * reach);
+        }
+
+        // each worker owned a contiguous range of particles, so concatenating the per-worker lists in order yields
+        // the CSR arrays directly
+        offsets.resize(n + 1);
+        offsets[0] = 0;
+        for (std::size_t i = 0; i < n; i++) {
+            offsets[i + 1] = offsets[i] + thread_counts[i];
+        }
+        neighbours.clear();
+        neighbours.reserve(offsets[n]);
+        for (const std::vector<std::uint32_t>& list : thread_lists) {
+            neighbours.insert(neighbours.end(), list.begin(), list.end());
+        }
+    }
+
+    // Cell list by counting sort, then a scan of the 3 x 3 block of cells around each particle.
+    void search_cells(const ParticleSystem& p, int cells, double reach2) {
+        const std::size_t n = p.size();
+        const double inv_cell = cells / box;
+        std::vector<std::uint32_t> cell_of(n);
+        cell_start.assign(static_cast<std::size_t>(cells) * cells + 1, 0);
+        for (std::size_t i = 0; i < n; i++) {
+            int cx = std::min(cells - 1, static_cast<int>(p.x[i] * inv_cell));
+            int cy = std::min(cells - 1, static_cast<int>(p.y[i] * inv_cell));
+            cell_of[i] = static_cast<std::uint32_t>(cy * cells + cx);
+            cell_start[cell_of[i] + 1]++;
+        }
+        for (std::size_t c = 0; c + 1 < cell_start.size(); c++) {
+            cell_start[c + 1] += cell_start[c];
+        }
+        cell_particles.resize(n);
+        cell_x.resize(n);
+        cell_y.resize(n);
+        std::vector<std::uint32_t> fill(cell_start.begin(), cell_start.end() - 1);
+        for (std::size_t i = 0; i < n; i++) {
+            std::uint32_t slot = fill[cell_of[i]]++;
+            cell_particles[slot] = static_cast<std::uint32_t>(i);
+            cell_x[slot] = p.x[i];
+            cell_y[slot] = p.y[i];
+        }
+
+        pool.parallel_for(0, n, [&](std::size_t lo, std::size_t hi, unsigned worker) {
+            std::vector<std::uint32_t>& out = thread_lists[worker];
+            for (std::size_t i = lo; i < hi; i++) {
+                int cx = static_cast<int>(cell_of[i] % cells);
+                int cy = static_cast<int>(cell_of[i] / cells);
+                std::uint32_t count = 0;
+                for (int oy = -1; oy <= 1; oy++) {
+                    for (int ox = -1; ox <= 1; ox++) {
+                        // periodic wrap handled once per cell as a position shift, not per candidate
+                        int nx = cx + ox, ny = cy + oy;
+                        double shift_x = (nx < 0) ? -box : (nx >= cells) ? box : 0.0;
+                        double shift_y = (ny < 0) ? -box : (ny >= cells) ? box : 0.0;
+                        nx = (nx + cells) % cells;
+                        ny = (ny + cells) % cells;
+                        std::size_t c = static_cast<std::size_t>(ny) * cells + nx;
+                        const double xi = p.x[i] - shift_x, yi = p.y[i] - shift_y;
+                        for (std::uint32_t s = cell_start[c]; s < cell_start[c + 1]; s++) {
+                            double dx = xi - cell_x[s];
+                            double dy = yi - cell_y[s];
+                            if (dx * dx + dy * dy < reach2 && cell_particles[s] != i) {
+                                out.push_back(cell_particles[s]);
+                                count++;
+                            }
+                        }
+                    }
+                }
+                thread_counts[i] = count;
+            }
+        });
+    }
+
+    // Small boxes: every other particle is a candidate, with the minimum image taken per pair.
+    void search_all_pairs(const ParticleSystem& p, double reach2) {
+        const std::size_t n = p.size();
+        const double inv_box = 1.0 / box;
+        pool.parallel_for(0, n, [&](std::size_t lo, std::size_t hi, unsigned worker) {
+            std::vector<std::uint32_t>& out = thread_lists[worker];
+            for (std::size_t i = lo; i < hi; i++) {
+                std::uint32_t count = 0;
+                for (std::size_t j = 0; j < n; j++) {
+                    double dx = p.x[i] - p.x[j];
+                    double dy = p.y[i] - p.y[j];
+                    dx -= box * std::floor(dx * inv_box + 0.5);
+                    dy -= box * std::floor(dy * inv_box + 0.5);
+                    if (dx * dx + dy * dy < reach2 && j != i) {
+                        out.push_back(static_cast<std::uint32_t>(j));
+                        count++;
+                    }
+                }
+                thread_counts[i] = count;
+            }
+        });
+    }
+};
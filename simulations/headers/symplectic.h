@@ -0,0 +1,278 @@
+// SYMPLECTIC ORBITAL INTEGRATORS
+// ARC PROJECTS - SIMULATION PROJECT 16-10-2026
+// Planets orbiting a fixed central mass, with Newtonian 1/r^2 gravity restricted to the orbital plane. The central
+// body sits at the origin with gravitational parameter mu = G M; the planets also attract each other.
+//
+// Symplectic methods preserve the geometric structure of Hamiltonian flow, so the energy error stays bounded and
+// oscillates instead of drifting, however long the run. That lets us take far larger steps for the same long-term
+// accuracy than a general-purpose method such as RK4.
+//   leapfrog      - 2nd order, one force evaluation per step
+//   yoshida 4/6   - symmetric compositions of leapfrog substeps (3 and 7 force evaluations per step)
+//   wisdom-holman - splits H = H_kepler + H_interaction; the Kepler part is solved exactly with universal variables,
+//                   so only the small planet-planet forces are approximated and dt can be a sizeable orbit fraction
+//
+// Positions are accumulated with Kahan compensation: over millions of steps the increments dt * v are tiny next to
+// the position itself, and naive addition would lose their low-order bits every step.
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+struct OrbitalSystem {
+    double mu = 1.0;  // G * central mass
+    double G = 1.0;
+    std::vector<double> x, y, vx, vy, m;
+    std::vector<double> comp_x, comp_y;  // Kahan compensation terms for the positions
+    std::vector<double> ax, ay;          // scratch
+
+    std::size_t size() const { return x.size(); }
+
+    void add(double px, double py, double pvx, double pvy, double mass) {
+        x.push_back(px); y.push_back(py);
+        vx.push_back(pvx); vy.push_back(pvy);
+        m.push_back(mass);
+        comp_x.push_back(0.0); comp_y.push_back(0.0);
+        ax.push_back(0.0); ay.push_back(0.0);
+    }
+
+    // x += dx with compensated summation
+    void move(std::size_t i, double dx, double dy) {
+        double yx = dx - comp_x[i];
+        double tx = x[i] + yx;
+        comp_x[i] = (tx - x[i]) - yx;
+        x[i] = tx;
+        double yy = dy - comp_y[i];
+        double ty = y[i] + yy;
+        comp_y[i] = (ty - y[i]) - yy;
+        y[i] = ty;
+    }
+};
+
+// Accelerations from the planets on each other only.
+inline void interaction_accelerations(OrbitalSystem& s) {
+    const std::size_t n = s.size();
+    for (std::size_t i = 0; i < n; i++) {
+        s.ax[i] = 0.0;
+        s.ay[i] = 0.0;
+    }
+    for (std::size_t i = 0; i < n; i++) {
+        for (std::size_t j = i + 1; j < n; j++) {
+            double dx = s.x[j] - s.x[i];
+            double dy = s.y[j] - s.y[i];
+            double r2 = dx * dx + dy * dy;
+            double inv_r3 = s.G / (r2 * std::sqrt(r2));
+            s.ax[i] += s.m[j] * inv_r3 * dx; s.ay[i] += s.m[j] * inv_r3 * dy;
+            s.ax[j] -= s.m[i] * inv_r3 * dx; s.ay[j] -= s.m[i] * inv_r3 * dy;
+        }
+    }
+}
+
+// Central body plus planet-planet accelerations.
+inline void total_accelerations(OrbitalSystem& s) {
+    interaction_accelerations(s);
+    for (std::size_t i = 0; i < s.size(); i++) {
+        double r2 = s.x[i] * s.x[i] + s.y[i] * s.y[i];
+        double inv_r3 = s.mu / (r2 * std::sqrt(r2));
+        s.ax[i] -= inv_r3 * s.x[i];
+        s.ay[i] -= inv_r3 * s.y[i];
+    }
+}
+
+struct OrbitalInvariants {
+    double energy = 0.0;
+    double angular_momentum = 0.0;
+};
+
+inline OrbitalInvariants invariants(const OrbitalSystem& s) {
+    OrbitalInvariants result;
+    const std::size_t n = s.size();
+    for (std::size_t i = 0; i < n; i++) {
+        double r = std::sqrt(s.x[i] * s.x[i] + s.y[i] * s.y[i]);
+        result.energy += 0.5 * s.m[i] * (s.vx[i] * s.vx[i] + s.vy[i] * s.vy[i]) - s.mu * s.m[i] / r;
+        result.angular_momentum += s.m[i] * (s.x[i] * s.vy[i] - s.y[i] * s.vx[i]);
+        for (std::size_t j = i + 1; j < n; j++) {
+            double dx = s.x[j] - s.x[i], dy = s.y[j] - s.y[i];
+            result.energy -= s.G * s.m[i] * s.m[j] / std::sqrt(dx * dx + dy * dy);
+        }
+    }
+    return result;
+}
+
+// Tracks the largest relative drift of energy and angular momentum from their initial values. Sampling every few
+// hundred steps keeps the O(N^2) energy evaluation out of the hot loop.
+struct InvariantMonitor {
+    OrbitalInvariants initial;
+    double max_energy_error = 0.0;
+    double max_momentum_error = 0.0;
+
+    explicit InvariantMonitor(const OrbitalSystem& s) : initial(invariants(s)) {}
+
+    void sample(const OrbitalSystem& s) {
+        OrbitalInvariants now = invariants(s);
+        max_energy_error = std::max(max_energy_error, std::abs((now.energy - initial.energy) / initial.energy));
+        max_momentum_error = std::max(max_momentum_error,
+                                      std::abs((now.angular_momentum - initial.angular_momentum) / initial.angular_momentum));
+    }
+};
+
+// ---------------------------------------------------------------------------------------------------------------
+// Composition methods built on leapfrog
+
+// Drift-kick-drift leapfrog substep of length h.
+inline void leapfrog_substep(OrbitalSystem& s, double h) {
+    const std::size_t n = s.size();
+    for (std::size_t i = 0; i < n; i++) {
+        s.move(i, 0.5 * h * s.vx[i], 0.5 * h * s.vy[i]);
+    }
+    total_accelerations(s);
+    for (std::size_t i = 0; i < n; i++) {
+        s.vx[i] += h * s.ax[i];
+        s.vy[i] += h * s.ay[i];
+    }
+    for (std::size_t i = 0; i < n; i++) {
+        s.move(i, 0.5 * h * s.vx[i], 0.5 * h * s.vy[i]);
+    }
+}
+
+inline void leapfrog_step(OrbitalSystem& s, double dt) {
+    leapfrog_substep(s, dt);
+}
+
+// Yoshida (1990) triple jump: w1, w0, w1 with w1 = 1 / (2 - 2^(1/3)), w0 = 1 - 2 w1.
+inline void yoshida4_step(OrbitalSystem& s, double dt) {
+    const double cbrt2 = std::cbrt(2.0);
+    const double w1 = 1.0 / (2.0 - cbrt2);
+    const double w0 = -cbrt2 / (2.0 - cbrt2);
+    leapfrog_substep(s, w1 * dt);
+    leapfrog_substep(s, w0 * dt);
+    leapfrog_substep(s, w1 * dt);
+}
+
+// Yoshida (1990) sixth order, solution A: w3 w2 w1 w0 w1 w2 w3.
+inline void yoshida6_step(OrbitalSystem& s, double dt) {
+    const double w1 = -1.17767998417887;
+    const double w2 = 0.235573213359357;
+    const double w3 = 0.784513610477560;
+    const double w0 = 1.0 - 2.0 * (w1 + w2 + w3);
+    const double weights[7] = {w3, w2, w1, w0, w1, w2, w3};
+    for (double w : weights) {
+        leapfrog_substep(s, w * dt);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------
+// Wisdom-Holman
+
+// Stumpff functions C(z) and S(z) for the universal-variable Kepler solution.
+inline void stumpff(double z, double& c, double& s) {
+    if (z > 1e-3) {
+        double q = std::sqrt(z);
+        c = (1.0 - std::cos(q)) / z;
+        s = (q - std::sin(q)) / (z * q);
+    }
+    else if (z < -1e-3) {
+        double q = std::sqrt(-z);
+        c = (std::cosh(q) - 1.0) / -z;
+        s = (std::sinh(q) - q) / (-z * q);
+    }
+    else {
+        // series, exact to double precision for |z| < 1e-3
+        c = 1.0 / 2.0 - z / 24.0 + z * z / 720.0 - z * z * z / 40320.0;
+        s = 1.0 / 6.0 - z / 120.0 + z * z / 5040.0 - z * z * z / 362880.0;
+    }
+}
+
+// Advances body i along its unperturbed Kepler orbit about the central mass by dt, using the f and g functions.
+inline void kepler_drift(OrbitalSystem& s, std::size_t i, double dt) {
+    const double mu = s.mu;
+    const double sqrt_mu = std::sqrt(mu);
+    double x0 = s.x[i], y0 = s.y[i], vx0 = s.vx[i], vy0 = s.vy[i];
+    double r0 = std::sqrt(x0 * x0 + y0 * y0);
+    double v2 = vx0 * vx0 + vy0 * vy0;
+    double rv = (x0 * vx0 + y0 * vy0) / sqrt_mu;
+    double alpha = 2.0 / r0 - v2 / mu;  // 1 / semi-major axis
+
+    // Newton iteration for the universal anomaly chi
+    double chi = sqrt_mu * std::abs(alpha) * dt;
+    if (alpha <= 0.0 || chi == 0.0) {
+        chi = sqrt_mu * dt / r0;
+    }
+    double c = 0.5, st = 1.0 / 6.0, r = r0;
+    for (int iteration = 0; iteration < 50; iteration++) {
+        double chi2 = chi * chi;
+        stumpff(alpha * chi2, c, st);
+        double f = rv * chi2 * c + (1.0 - alpha * r0) * chi2 * chi * st + r0 * chi - sqrt_mu * dt;
+        r = rv * chi * (1.0 - alpha * chi2 * st) + (1.0 - alpha * r0) * chi2 * c + r0;
+        double delta = f / r;
+        chi -= delta;
+        if (std::abs(delta) <= 1e-15 * std::max(1.0, std::abs(chi))) {
+            break;
+        }
+    }
+    double chi2 = chi * chi;
+    stumpff(alpha * chi2, c, st);
+    double f = 1.0 - chi2 / r0 * c;
+    double g = dt - chi2 * chi / sqrt_mu * st;
+    double x1 = f * x0 + g * vx0;
+    double y1 = f * y0 + g * vy0;
+    double r1 = std::sqrt(x1 * x1 + y1 * y1);
+    double fdot = sqrt_mu / (r1 * r0) * (alpha * chi2 * chi * st - chi);
+    double gdot = 1.0 - chi2 / r1 * c;
+
+    // apply the position change as an increment so the compensated sum sees it
+    s.move(i, (f - 1.0) * x0 + g * vx0, (f - 1.0) * y0 + g * vy0);
+    s.vx[i] = fdot * x0 + gdot * vx0;
+    s.vy[i] = fdot * y0 + gdot * vy0;
+}
+
+// Kick (interaction) - drift (exact Kepler) - kick. Exact for a single planet, whatever dt.
+inline void wisdom_holman_step(OrbitalSystem& s, double dt) {
+    const std::size_t n = s.size();
+    interaction_accelerations(s);
+    for (std::size_t i = 0; i < n; i++) {
+        s.vx[i] += 0.5 * dt * s.ax[i];
+        s.vy[i] += 0.5 * dt * s.ay[i];
+    }
+    for (std::size_t i = 0; i < n; i++) {
+        kepler_drift(s, i, dt);
+    }
+    interaction_accelerations(s);
+    for (std::size_t i = 0; i < n; i++) {
+        s.vx[i] += 0.5 * dt * s.ax[i];
+        s.vy[i] += 0.5 * dt * s.ay[i];
+    }
+}
+
+// Classical RK4, not symplectic; included to show the secular energy drift the methods above avoid.
+inline void rk4_step(OrbitalSystem& s, double dt) {
+    const std::size_t n = s.size();
+    std::vector<double> x0 = s.x, y0 = s.y, vx0 = s.vx, vy0 = s.vy;
+    std::vector<double> kx(n, 0.0), ky(n, 0.0), kvx(n, 0.0), kvy(n, 0.0);
+    const double weight[4] = {1.0 / 6.0, 1.0 / 3.0, 1.0 / 3.0, 1.0 / 6.0};
+    const double offset[4] = {0.0, 0.5, 0.5, 1.0};
+    std::vector<double> sx(n), sy(n), svx(n), svy(n);
+    for (int stage = 0; stage < 4; stage++) {
+        total_accelerations(s);
+        for (std::size_t i = 0; i < n; i++) {
+            sx[i] = s.vx[i]; sy[i] = s.vy[i]; svx[i] = s.ax[i]; svy[i] = s.ay[i];
+            kx[i] += weight[stage] * sx[i]; ky[i] += weight[stage] * sy[i];
+            kvx[i] += weight[stage] * svx[i]; kvy[i] += weight[stage] * svy[i];
+        }
+        if (stage < 3) {
+            double h = offset[stage + 1] * dt;
+            for (std::size_t i = 0; i < n; i++) {
+                s.x[i] = x0[i] + h * sx[i]; s.y[i] = y0[i] + h * sy[i];
+                s.vx[i] = vx0[i] + h * svx[i]; s.vy[i] = vy0[i] + h * svy[i];
+            }
+        }
+    }
+    for (std::size_t i = 0; i < n; i++) {
+        s.x[i] = x0[i];
+        s.y[i] = y0[i];
+        s.move(i, dt * kx[i], dt * ky[i]);
+        s.vx[i] = vx0[i] + dt * kvx[i];
+        s.vy[i] = vy0[i] + dt * kvy[i];
+    }
+}
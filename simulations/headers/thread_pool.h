@@ -0,0 +1,103 @@
+// THREAD POOL
+// ARC PROJECTS - SIMULATION PROJECT 16-10-2026
+// Minimal persistent thread pool for the simulation kernels. Workers are created once and parked on a condition
+// variable, so a parallel loop costs a wake-up rather than a thread creation. The calling thread always works on the
+// first chunk itself.
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned threads = std::max(1u, std::thread::hardware_concurrency()))
+        : thread_count(std::max(1u, threads)) {
+        for (unsigned id = 1; id < thread_count; id++) {
+            workers.emplace_back([this, id] { worker_loop(id); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        start_cv.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return thread_count; }
+
+    // Splits [begin, end) into one contiguous chunk per thread and calls fn(lo, hi, worker_id) for each chunk,
+    // returning once every chunk is finished. Chunk boundaries depend only on the range and the thread count.
+    template <typename Fn>
+    void parallel_for(std::size_t begin, std::size_t end, Fn&& fn) {
+        if (end <= begin) {
+            return;
+        }
+        if (thread_count == 1 || end - begin < 2) {
+            fn(begin, end, 0u);
+            return;
+        }
+        const std::size_t count = end - begin;
+        const unsigned threads = thread_count;
+        std::function<void(unsigned)> task = [&, begin, count, threads](unsigned id) {
+            std::size_t lo = begin + count * id / threads;
+            std::size_t hi = begin + count * (id + 1) / threads;
+            if (lo < hi) {
+                fn(lo, hi, id);
+            }
+        };
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = task;
+            pending = thread_count - 1;
+            generation++;
+        }
+        start_cv.notify_all();
+        task(0);
+        std::unique_lock<std::mutex> lock(mutex);
+        done_cv.wait(lock, [this] { return pending == 0; });
+    }
+
+private:
+    unsigned thread_count;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable start_cv;
+    std::condition_variable done_cv;
+    std::function<void(unsigned)> job;
+    std::size_t generation = 0;
+    unsigned pending = 0;
+    bool stopping = false;
+
+    void worker_loop(unsigned id) {
+        std::size_t seen = 0;
+        while (true) {
+            std::unique_lock<std::mutex> lock(mutex);
+            start_cv.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+            std::function<void(unsigned)> task = job;
+            lock.unlock();
+            task(id);
+            lock.lock();
+            if (--pending == 0) {
+                done_cv.notify_one();
+            }
+        }
+    }
+};
@@ -0,0 +1,134 @@
+// STRONG UNITS AND COMPILE-TIME SUVAT
+// ARC PROJECTS - SIMULATION PROJECT 16-10-2026
+// A Quantity is a plain floating-point value tagged at compile time with its dimension, written as exponents of
+// length (L), mass (M) and time (T). The tag has no runtime representation: sizeof(Quantity<float, ...>) is
+// sizeof(float) and every operator is a constexpr one-liner, so optimised code is the same as for raw floats.
+// Adding a length to a time, or passing a velocity where an acceleration is expected, fails to compile.
+
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+
+template <int L, int M, int T>
+struct Dimension {
+    static constexpr int length = L;
+    static constexpr int mass = M;
+    static constexpr int time = T;
+};
+
+template <typename D1, typename D2>
+using DimensionProduct = Dimension<D1::length + D2::length, D1::mass + D2::mass, D1::time + D2::time>;
+
+template <typename D1, typename D2>
+using DimensionQuotient = Dimension<D1::length - D2::length, D1::mass - D2::mass, D1::time - D2::time>;
+
+template <typename Real, typename Dim>
+class Quantity {
+public:
+    using real_type = Real;
+    using dimension = Dim;
+
+    constexpr Quantity() = default;
+    constexpr explicit Quantity(Real v) : v(v) {}
+
+    constexpr Real value() const { return v; }
+
+    constexpr Quantity operator+(Quantity other) const { return Quantity(v + other.v); }
+    constexpr Quantity operator-(Quantity other) const { return Quantity(v - other.v); }
+    constexpr Quantity operator-() const { return Quantity(-v); }
+    constexpr Quantity& operator+=(Quantity other) { v += other.v; return *this; }
+    constexpr Quantity& operator-=(Quantity other) { v -= other.v; return *this; }
+    constexpr bool operator==(const Quantity&) const = default;
+    constexpr auto operator<=>(const Quantity&) const = default;
+
+private:
+    Real v = Real(0);
+};
+
+template <typename Real, typename D1, typename D2>
+constexpr Quantity<Real, DimensionProduct<D1, D2>> operator*(Quantity<Real, D1> a, Quantity<Real, D2> b) {
+    return Quantity<Real, DimensionProduct<D1, D2>>(a.value() * b.value());
+}
+
+template <typename Real, typename D1, typename D2>
+constexpr Quantity<Real, DimensionQuotient<D1, D2>> operator/(Quantity<Real, D1> a, Quantity<Real, D2> b) {
+    return Quantity<Real, DimensionQuotient<D1, D2>>(a.value() / b.value());
+}
+
+// scaling by a dimensionless number
+template <typename Real, typename D>
+constexpr Quantity<Real, D> operator*(Real s, Quantity<Real, D> q) { return Quantity<Real, D>(s * q.value()); }
+
+template <typename Real, typename D>
+constexpr Quantity<Real, D> operator*(Quantity<Real, D> q, Real s) { return Quantity<Real, D>(q.value() * s); }
+
+template <typename Real, typename D>
+constexpr Quantity<Real, D> operator/(Quantity<Real, D> q, Real s) { return Quantity<Real, D>(q.value() / s); }
+
+template <typename Real, typename D>
+Quantity<Real, Dimension<D::length / 2, D::mass / 2, D::time / 2>> sqrt(Quantity<Real, D> q) {
+    static_assert(D::length % 2 == 0 && D::mass % 2 == 0 && D::time % 2 == 0, "square root of an odd dimension");
+    return Quantity<Real, Dimension<D::length / 2, D::mass / 2, D::time / 2>>(std::sqrt(q.value()));
+}
+
+using Dimensionless = Dimension<0, 0, 0>;
+using LengthDim = Dimension<1, 0, 0>;
+using MassDim = Dimension<0, 1, 0>;
+using TimeDim = Dimension<0, 0, 1>;
+using VelocityDim = Dimension<1, 0, -1>;
+using AccelerationDim = Dimension<1, 0, -2>;
+
+template <typename Real = float> using Length = Quantity<Real, LengthDim>;
+template <typename Real = float> using Mass = Quantity<Real, MassDim>;
+template <typename Real = float> using Time = Quantity<Real, TimeDim>;
+template <typename Real = float> using Velocity = Quantity<Real, VelocityDim>;
+template <typename Real = float> using Acceleration = Quantity<Real, AccelerationDim>;
+
+static_assert(sizeof(Velocity<float>) == sizeof(float), "units must not add storage");
+static_assert(std::is_trivially_copyable_v<Velocity<float>>, "units must pass in registers like a float");
+
+// Literals for the common SI units, e.g. 9.81_mps2, 3.0_s
+namespace unit_literals {
+constexpr Length<float> operator""_m(long double v) { return Length<float>(static_cast<float>(v)); }
+constexpr Time<float> operator""_s(long double v) { return Time<float>(static_cast<float>(v)); }
+constexpr Mass<float> operator""_kg(long double v) { return Mass<float>(static_cast<float>(v)); }
+constexpr Velocity<float> operator""_mps(long double v) { return Velocity<float>(static_cast<float>(v)); }
+constexpr Acceleration<float> operator""_mps2(long double v) { return Acceleration<float>(static_cast<float>(v)); }
+}
+
+// SUVAT equations for constant acceleration
+//   s = displacement, u = initial velocity, v = final velocity, a = acceleration, t = time elapsed
+namespace suvat {
+
+// v = u + a t
+template <typename Real>
+constexpr Velocity<Real> final_velocity(Velocity<Real> u, Acceleration<Real> a, Time<Real> t) {
+    return u + a * t;
+}
+
+// s = u t + 1/2 a t^2
+template <typename Real>
+constexpr Length<Real> displacement(Velocity<Real> u, Acceleration<Real> a, Time<Real> t) {
+    return u * t + Real(0.5) * a * t * t;
+}
+
+// s = 1/2 (u + v) t
+template <typename Real>
+constexpr Length<Real> displacement_from_velocities(Velocity<Real> u, Velocity<Real> v, Time<Real> t) {
+    return Real(0.5) * (u + v) * t;
+}
+
+// v^2 = u^2 + 2 a s
+template <typename Real>
+Velocity<Real> final_velocity_from_displacement(Velocity<Real> u, Acceleration<Real> a, Length<Real> s) {
+    return sqrt(u * u + Real(2) * a * s);
+}
+
+// t = (v - u) / a
+template <typename Real>
+constexpr Time<Real> time_to_reach(Velocity<Real> u, Velocity<Real> v, Acceleration<Real> a) {
+    return (v - u) / a;
+}
+
+}
@@ -0,0 +1,72 @@
+// MOLECULAR DYNAMICS - SHORT-RANGE FORCES
+// ARC PROJECTS - SIMULATION PROJECT 16-10-2026
+// A two-dimensional Lennard-Jones fluid in a periodic box, integrated with the same leapfrog integrator as the
+// N-body solver but with the cell/neighbour-list engine from headers/short_range.h. Reports time per step against
+// particle count (it should grow linearly), how often the neighbour list is rebuilt, and total energy drift.
+//
+// Reduced units: sigma = epsilon = mass = 1.
+// Build: g++ -std=c++20 -O3 -march=native -pthread molecular_dynamics.cpp -o molecular_dynamics
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+#include "headers/particle_system.h"
+#include "headers/short_range.h"
+
+// particles on a square lattice at the given number density, with random velocities at roughly unit temperature
+ParticleSystem lattice(std::size_t side, double density, double& box) {
+    double spacing = 1.0 / std::sqrt(density);
+    box = side * spacing;
+    ParticleSystem p;
+    p.reserve(side * side);
+    std::mt19937 rng(9);
+    std::normal_distribution<double> velocity(0.0, 1.0);
+    for (std::size_t j = 0; j < side; j++) {
+        for (std::size_t i = 0; i < side; i++) {
+            p.add((i + 0.5) * spacing, (j + 0.5) * spacing, velocity(rng), velocity(rng), 1.0);
+        }
+    }
+    // remove the net momentum so the box does not drift
+    double mx = 0.0, my = 0.0;
+    for (std::size_t i = 0; i < p.size(); i++) {
+        mx += p.vx[i];
+        my += p.vy[i];
+    }
+    for (std::size_t i = 0; i < p.size(); i++) {
+        p.vx[i] -= mx / p.size();
+        p.vy[i] -= my / p.size();
+    }
+    return p;
+}
+
+int main() {
+    std::cout << "Molecular dynamics: Lennard-Jones fluid with cell and neighbour lists." << std::endl;
+
+    ThreadPool pool;
+    const double dt = 0.005;
+    const int steps = 50;
+    std::cout << "\nparticles   ms/step   ns/particle/step   rebuilds   neighbours/particle   energy drift" << std::endl;
+    for (std::size_t side : {100, 200, 500, 1000}) {
+        double box;
+        ParticleSystem p = lattice(side, 0.7, box);
+        ShortRangeEngine<LennardJones> engine(LennardJones{}, box, pool);
+        LeapfrogIntegrator<ShortRangeEngine<LennardJones>> integrator{engine};
+        integrator.prime(p);
+        double e0 = kinetic_energy(p) + engine.potential_energy();
+
+        auto start = std::chrono::steady_clock::now();
+        for (int step = 0; step < steps; step++) {
+            integrator.step(p, dt);
+        }
+        auto end = std::chrono::steady_clock::now();
+        double per_step = std::chrono::duration<double>(end - start).count() / steps;
+        double e1 = kinetic_energy(p) + engine.potential_energy();
+
+        std::cout << p.size() << "\t" << per_step * 1e3 << "\t" << per_step * 1e9 / p.size() << "\t"
+                  << engine.rebuilds() << "\t" << static_cast<double>(engine.pair_entries()) / p.size() << "\t"
+                  << std::abs((e1 - e0) / e0) << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,127 @@
+// N-BODY SOLVER
+// ARC PROJECTS - SIMULATION PROJECT 16-10-2026
+// Extends the single point mass of classical_mechanics_solver.cpp to many mutually attracting bodies in the plane.
+// Two interchangeable force engines share the same particle storage and leapfrog integrator:
+//   direct - exact O(N^2) pairwise sum, used as the reference
+//   fmm    - fast multipole method, near-linear in N with a tunable expansion order
+//
+// Build: g++ -std=c++20 -O2 n_body_solver.cpp -o n_body_solver
+// Usage: ./n_body_solver [direct|fmm] [particles] [order]
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "headers/fmm_2d.h"
+#include "headers/particle_system.h"
+
+ParticleSystem make_disc(std::size_t n, unsigned seed) {
+    ParticleSystem p;
+    p.reserve(n);
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    const double pi = 3.14159265358979323846;
+    for (std::size_t i = 0; i < n; i++) {
+        double r = std::sqrt(unit(rng));
+        double theta = 2.0 * pi * unit(rng);
+        // slow rotation so the disc does not collapse immediately
+        p.add(r * std::cos(theta), r * std::sin(theta), -0.5 * r * std::sin(theta), 0.5 * r * std::cos(theta), 1.0 / n);
+    }
+    return p;
+}
+
+template <typename ForceEngine>
+double time_engine(ForceEngine& engine, ParticleSystem& p) {
+    auto start = std::chrono::steady_clock::now();
+    engine.compute_accelerations(p);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+// root-mean-square error of the acceleration field relative to the reference field
+double relative_error(const ParticleSystem& approx, const ParticleSystem& exact) {
+    double num = 0.0, den = 0.0;
+    for (std::size_t i = 0; i < exact.size(); i++) {
+        double dx = approx.ax[i] - exact.ax[i];
+        double dy = approx.ay[i] - exact.ay[i];
+        num += dx * dx + dy * dy;
+        den += exact.ax[i] * exact.ax[i] + exact.ay[i] * exact.ay[i];
+    }
+    return std::sqrt(num / den);
+}
+
+template <typename ForceEngine>
+void run(ForceEngine& engine, std::size_t n) {
+    ParticleSystem p = make_disc(n, 7);
+    LeapfrogIntegrator<ForceEngine> integrator{engine};
+    integrator.prime(p);
+    double dt = 1e-3;
+    auto start = std::chrono::steady_clock::now();
+    for (int step = 1; step <= 10; step++) {
+        integrator.step(p, dt);
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "10 steps of " << n << " bodies took " << std::chrono::duration<double>(end - start).count()
+              << " s, kinetic energy " << kinetic_energy(p) << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::cout << "N-body solver: direct summation vs fast multipole method." << std::endl;
+
+    if (argc > 1) {
+        std::string engine_name = argv[1];
+        std::size_t n = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 100000;
+        if (engine_name == "direct") {
+            DirectSumEngine engine;
+            run(engine, n);
+        }
+        else if (engine_name == "fmm") {
+            FmmEngine engine;
+            if (argc > 3) {
+                engine.order = std::atoi(argv[3]);
+            }
+            run(engine, n);
+        }
+        else {
+            std::cerr << "Usage: " << argv[0] << " [direct|fmm] [particles] [order]" << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // accuracy vs time as the expansion order increases; the error floor at high order comes from the softening,
+    // which the multipole engine only applies in the near field
+    const std::size_t n_ref = 4000;
+    ParticleSystem exact = make_disc(n_ref, 1);
+    DirectSumEngine direct;
+    double direct_time = time_engine(direct, exact);
+    std::cout << "\nN = " << n_ref << ", direct sum: " << direct_time << " s" << std::endl;
+    std::cout << "order   rel. error     time (s)" << std::endl;
+    for (int order : {2, 4, 8, 12, 16, 20}) {
+        ParticleSystem approx = make_disc(n_ref, 1);
+        FmmEngine fmm;
+        fmm.order = order;
+        double t = time_engine(fmm, approx);
+        std::cout << order << "\t" << relative_error(approx, exact) << "\t" << t << std::endl;
+    }
+
+    // scaling with N at a fixed order; direct timings beyond 16k bodies are extrapolated as N^2
+    std::cout << "\nParticles   fmm (s)      direct (s)" << std::endl;
+    for (std::size_t n = 4000; n <= 1024000; n *= 4) {
+        ParticleSystem p = make_disc(n, 2);
+        FmmEngine fmm;
+        double t_fmm = time_engine(fmm, p);
+        double t_direct;
+        if (n <= 16000) {
+            t_direct = time_engine(direct, p);
+        }
+        else {
+            t_direct = direct_time * (static_cast<double>(n) / n_ref) * (static_cast<double>(n) / n_ref);
+        }
+        std::cout << n << "\t" << t_fmm << "\t" << t_direct << ((n > 16000) ? " (est.)" : "") << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+// ORBITAL INTEGRATOR
+// ARC PROJECTS - SIMULATION PROJECT 16-10-2026
+// Long-horizon orbit integration comparing symplectic methods against RK4. For each method we report the worst
+// relative energy and angular momentum error seen by the online monitor, and the wall time.
+//
+// Units: G = 1, central mass = 1, so a circular orbit of radius 1 has period 2 pi.
+// Build: g++ -std=c++20 -O2 orbital_integrator.cpp -o orbital_integrator
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+#include "headers/symplectic.h"
+
+const double pi = 3.14159265358979323846;
+
+// Single planet on an eccentric orbit, starting at perihelion.
+OrbitalSystem kepler_orbit(double eccentricity) {
+    OrbitalSystem s;
+    double a = 1.0;
+    double r_peri = a * (1.0 - eccentricity);
+    double v_peri = std::sqrt((1.0 + eccentricity) / (1.0 - eccentricity) / a);
+    s.add(r_peri, 0.0, 0.0, v_peri, 1e-6);
+    return s;
+}
+
+// Two giant planets with Jupiter/Saturn-like mass ratios and orbital radii.
+OrbitalSystem two_planets() {
+    OrbitalSystem s;
+    s.add(5.2, 0.0, 0.0, std::sqrt(1.0 / 5.2), 9.5e-4);
+    s.add(-9.5, 0.0, 0.0, -std::sqrt(1.0 / 9.5), 2.9e-4);
+    return s;
+}
+
+template <typename Step>
+void run(const std::string& name, OrbitalSystem s, Step step, double dt, long steps, int evaluations_per_step) {
+    InvariantMonitor monitor(s);
+    auto start = std::chrono::steady_clock::now();
+    for (long k = 1; k <= steps; k++) {
+        step(s, dt);
+        if (k % 256 == 0) {
+            monitor.sample(s);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    monitor.sample(s);
+    std::cout << name << "\t" << evaluations_per_step << "\t" << monitor.max_energy_error << "\t"
+              << monitor.max_momentum_error << "\t" << std::chrono::duration<double>(end - start).count() << std::endl;
+}
+
+int main() {
+    std::cout << "Symplectic orbital integrators with energy-conservation monitoring." << std::endl;
+
+    // same step for everyone: 200 steps per orbit, e = 0.5, 10,000 orbits = 2 million steps
+    double period = 2.0 * pi;
+    double dt = period / 200.0;
+    long steps = 2000000;
+    std::cout << "\nKepler orbit, e = 0.5, " << steps << " steps of " << dt << std::endl;
+    std::cout << "method\tforces/step\tmax |dE/E|\tmax |dL/L|\ttime (s)" << std::endl;
+    run("rk4     ", kepler_orbit(0.5), rk4_step, dt, steps, 4);
+    run("leapfrog", kepler_orbit(0.5), leapfrog_step, dt, steps, 1);
+    run("yoshida4", kepler_orbit(0.5), yoshida4_step, dt, steps, 3);
+    run("yoshida6", kepler_orbit(0.5), yoshida6_step, dt, steps, 7);
+    run("w-h     ", kepler_orbit(0.5), wisdom_holman_step, dt, steps, 1);
+
+    // the real win: Wisdom-Holman holds accuracy at steps far too large for the others
+    double big_dt = period / 20.0;
+    long big_steps = steps / 10;
+    std::cout << "\nSame orbit, 10x larger step (" << big_dt << "), same simulated time" << std::endl;
+    std::cout << "method\tforces/step\tmax |dE/E|\tmax |dL/L|\ttime (s)" << std::endl;
+    run("leapfrog", kepler_orbit(0.5), leapfrog_step, big_dt, big_steps, 1);
+    run("yoshida6", kepler_orbit(0.5), yoshida6_step, big_dt, big_steps, 7);
+    run("w-h     ", kepler_orbit(0.5), wisdom_holman_step, big_dt, big_steps, 1);
+
+    // interacting planets; one step is 1/20 of the inner orbit
+    double inner_period = 2.0 * pi * std::pow(5.2, 1.5);
+    double planet_dt = inner_period / 20.0;
+    long planet_steps = 1000000;
+    std::cout << "\nTwo interacting planets, " << planet_steps << " steps of " << planet_dt << " (~"
+              << planet_steps / 20 << " inner orbits)" << std::endl;
+    std::cout << "method\tforces/step\tmax |dE/E|\tmax |dL/L|\ttime (s)" << std::endl;
+    run("leapfrog", two_planets(), leapfrog_step, planet_dt, planet_steps, 1);
+    run("yoshida4", two_planets(), yoshida4_step, planet_dt, planet_steps, 3);
+    run("w-h     ", two_planets(), wisdom_holman_step, planet_dt, planet_steps, 1);
+    return 0;
+}
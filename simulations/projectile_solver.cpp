@@ -0,0 +1,81 @@
+// PROJECTILE SOLVER
+// ARC PROJECTS - SIMULATION PROJECT 16-10-2026
+// classical_mechanics_solver.cpp only handles a straight drop with constant g and no air. This demo launches
+// projectiles with drag, wind and altitude-dependent gravity, and finds the apex and impact precisely with a root
+// finder on the step interpolant instead of by shrinking the time step.
+//
+// Build: g++ -std=c++20 -O2 -pthread projectile_solver.cpp -o projectile_solver
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+#include "headers/projectile.h"
+
+int main() {
+    std::cout << "Projectile solver with drag, wind and event detection." << std::endl;
+    const double pi = 3.14159265358979323846;
+
+    // vacuum check against the SUVAT answer t = 2 u sin(theta) / g, at deliberately coarse steps
+    ProjectileParams vacuum;
+    vacuum.air_density = 0.0;
+    vacuum.planet_radius = 1e300;  // constant gravity
+    double u = 50.0, theta = pi / 4.0;
+    double exact_time = 2.0 * u * std::sin(theta) / vacuum.g0;
+    std::cout << "\nVacuum flight, exact time of flight " << exact_time << " s" << std::endl;
+    std::cout << "dt (s)   flight time (s)   error (s)   steps" << std::endl;
+    for (double dt : {0.5, 0.1, 0.01}) {
+        ProjectileSolver solver(vacuum);
+        solver.dt = dt;
+        TrajectoryResult r = solver.solve(u, theta);
+        std::cout << dt << "\t" << r.flight_time << "\t" << std::abs(r.flight_time - exact_time) << "\t" << r.steps << std::endl;
+    }
+
+    // with drag and a head wind
+    ProjectileParams air;
+    air.wind_x = -5.0;
+    ProjectileSolver solver(air);
+    TrajectoryResult r = solver.solve(u, theta);
+    std::cout << "\nWith drag and a 5 m/s head wind:" << std::endl;
+    std::cout << "Apex: " << r.apex_height << " m at " << r.apex_time << " s" << std::endl;
+    std::cout << "Impact: " << r.range << " m downrange at " << r.flight_time << " s, " << r.impact_speed << " m/s" << std::endl;
+
+    // launch angle x speed sweep across all cores
+    const std::size_t n_speed = 400, n_angle = 400;
+    std::vector<double> speeds(n_speed), angles(n_angle);
+    for (std::size_t i = 0; i < n_speed; i++) {
+        speeds[i] = 10.0 + 290.0 * i / (n_speed - 1);
+    }
+    for (std::size_t j = 0; j < n_angle; j++) {
+        angles[j] = (1.0 + 88.0 * j / (n_angle - 1)) * pi / 180.0;
+    }
+    std::vector<TrajectoryResult> results;
+    unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "\nSweep of " << n_speed * n_angle << " trajectories" << std::endl;
+    std::cout << "threads   time (s)   trajectories/s" << std::endl;
+    for (unsigned threads : {1u, max_threads}) {
+        ThreadPool pool(threads);
+        auto start = std::chrono::steady_clock::now();
+        solver.sweep(speeds, angles, pool, results);
+        auto end = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double>(end - start).count();
+        std::cout << threads << "\t" << elapsed << "\t" << results.size() / elapsed << std::endl;
+        if (max_threads == 1) {
+            break;
+        }
+    }
+
+    // best angle for a few launch speeds; drag pulls it below the vacuum optimum of 45 degrees
+    std::cout << "\nspeed (m/s)   best angle (deg)   range (m)" << std::endl;
+    for (std::size_t i = 0; i < n_speed; i += n_speed / 5) {
+        std::size_t best = 0;
+        for (std::size_t j = 0; j < n_angle; j++) {
+            if (results[i * n_angle + j].range > results[i * n_angle + best].range) {
+                best = j;
+            }
+        }
+        std::cout << speeds[i] << "\t" << angles[best] * 180.0 / pi << "\t" << results[i * n_angle + best].range << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,149 @@
+// RIGID BODY ENGINE - PILE OF BOXES BENCHMARK
+// ARC PROJECTS - SIMULATION PROJECT 16-10-2026
+// classical_mechanics_solver.cpp treats a single point mass with no extent. Here bodies have size, orientation and a
+// moment of inertia, and collide with each other. Two benchmarks:
+//   1. pile of boxes - boxes (and a few circles) dropped onto the ground, timed per phase over a fixed number of
+//                      frames. The simulation then carries on until the pile has settled: every body still on the
+//                      ground below 0.1 m/s for a whole second. Bodies that rolled off the end of the ground are
+//                      counted but not judged. The program exits with 1 if a pile has not settled after a minute
+//   2. broad phase   - 100k bodies scattered over a plane, pair finding timed against the thread count
+//
+// Build: g++ -std=c++20 -O2 -pthread rigid_body_engine.cpp -o rigid_body_engine
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+
+#include "headers/rigid_body.h"
+
+// Returns whether the pile settled.
+bool pile_of_boxes(int columns, int rows, int frames) {
+    RigidBodyWorld world;
+    world.bodies.push_back(RigidBody::box({0.0, -1.0}, {columns * 1.5 + 10.0, 1.0}, 0.0));  // static ground
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> jitter(-0.05, 0.05);
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < columns; c++) {
+            Vec2 at = {(c - columns / 2) * 1.2 + jitter(rng), 0.5 + r * 1.1};
+            if ((r * columns + c) % 10 == 9) {
+                RigidBody ball = RigidBody::circle(at, 0.5, 1.0);
+                ball.rolling_resistance = 0.05;
+                world.bodies.push_back(ball);
+            }
+            else {
+                world.bodies.push_back(RigidBody::box(at, {0.5, 0.5}, 1.0));
+            }
+        }
+    }
+
+    StepTimings timings;
+    const double dt = 1.0 / 60.0;
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        world.step(dt, &timings);
+    }
+    auto end = std::chrono::steady_clock::now();
+    double total = std::chrono::duration<double>(end - start).count();
+
+    // bodies below the ground's top have rolled off its end and are falling; the rest are on the pile
+    const double settle_speed = 0.1;     // m/s
+    const int settle_frames = 60;        // frames the pile must stay below settle_speed
+    const int max_frames = 3600;
+    double max_speed = 0.0;
+    int moving = 0, fallen = 0, quiet = 0, frame = frames;
+    auto survey = [&] {
+        max_speed = 0.0;
+        moving = 0;
+        fallen = 0;
+        for (const RigidBody& b : world.bodies) {
+            if (b.inv_mass == 0.0) {
+                continue;
+            }
+            if (b.position.y < 0.0) {
+                fallen++;
+                continue;
+            }
+            const double speed = std::sqrt(dot(b.velocity, b.velocity));
+            max_speed = std::max(max_speed, speed);
+            moving += speed > settle_speed ? 1 : 0;
+        }
+    };
+    survey();
+    double max_penetration = 0.0;
+    for (const Manifold& m : world.contacts()) {
+        for (int k = 0; k < m.count; k++) {
+            max_penetration = std::max(max_penetration, m.points[k].penetration);
+        }
+    }
+
+    std::cout << "Pile of " << columns * rows << " bodies, " << frames << " frames: " << total << " s ("
+              << 1000.0 * total / frames << " ms/frame)" << std::endl;
+    std::cout << "  broad phase " << timings.broad << " s, narrow phase " << timings.narrow << " s, solver "
+              << timings.solve << " s" << std::endl;
+    std::cout << "  contacts in last frame: " << world.contacts().size() << ", max penetration " << max_penetration
+              << " m" << std::endl;
+    std::cout << "  after " << frames << " frames: " << moving << " of " << columns * rows << " bodies above "
+              << settle_speed << " m/s (max " << max_speed << " m/s)" << std::endl;
+
+    while (quiet < settle_frames && frame < max_frames) {
+        world.step(dt);
+        frame++;
+        survey();
+        quiet = (max_speed < settle_speed) ? quiet + 1 : 0;
+    }
+    const bool settled = quiet >= settle_frames;
+    if (settled) {
+        std::cout << "  settled after " << frame - settle_frames << " frames (max speed " << max_speed << " m/s), "
+                  << fallen << " rolled off the ground" << std::endl;
+    }
+    else {
+        std::cout << "  NOT settled after " << frame << " frames: " << moving << " bodies above " << settle_speed
+                  << " m/s (max " << max_speed << " m/s)" << std::endl;
+    }
+    return settled;
+}
+
+void broad_phase_scaling(std::size_t n) {
+    std::mt19937 rng(11);
+    // density chosen so each body overlaps a handful of neighbours, similar to a settled pile
+    double extent = std::sqrt(static_cast<double>(n)) * 1.2;
+    std::uniform_real_distribution<double> coord(0.0, extent);
+    std::uniform_real_distribution<double> angle(0.0, 3.14159);
+    std::vector<RigidBody> bodies;
+    bodies.reserve(n);
+    for (std::size_t i = 0; i < n; i++) {
+        RigidBody b = RigidBody::box({coord(rng), coord(rng)}, {0.5, 0.5}, 1.0);
+        b.angle = angle(rng);
+        bodies.push_back(b);
+    }
+
+    unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "\nBroad phase, " << n << " bodies" << std::endl;
+    std::cout << "threads   pairs     ms/frame" << std::endl;
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        ThreadPool pool(threads);
+        SpatialHashGrid grid;
+        std::vector<BodyPair> pairs;
+        grid.find_pairs(bodies, pool, pairs);  // warm up allocations
+        const int repeats = 20;
+        auto start = std::chrono::steady_clock::now();
+        for (int k = 0; k < repeats; k++) {
+            grid.find_pairs(bodies, pool, pairs);
+        }
+        auto end = std::chrono::steady_clock::now();
+        std::cout << threads << "\t" << pairs.size() << "\t"
+                  << 1000.0 * std::chrono::duration<double>(end - start).count() / repeats << std::endl;
+        if (threads * 2 > max_threads && threads != max_threads) {
+            threads = max_threads / 2;
+        }
+    }
+}
+
+int main() {
+    std::cout << "Rigid body engine: pile of boxes benchmark." << std::endl;
+    bool settled = pile_of_boxes(10, 10, 300);
+    settled = pile_of_boxes(40, 25, 300) && settled;
+    broad_phase_scaling(100000);
+    return settled ? 0 : 1;
+}
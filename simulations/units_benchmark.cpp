@@ -0,0 +1,100 @@
+// UNITS BENCHMARK
+// ARC PROJECTS - SIMULATION PROJECT 16-10-2026
+// Shows that the strong-units layer in headers/units.h costs nothing at runtime. The same SUVAT kernel is run over
+// large arrays twice, once on raw floats and once on Quantity types; the timing ratio shows the two run at the same
+// speed, and the outputs are compared bit for bit. The generated code is not claimed to be identical: without
+// __restrict the raw kernel has to reload t[i] after each store because the float arrays may alias, and the
+// scheduling of the two loops differs. Neither shows up in the timing.
+//
+// The outputs match bit for bit only without fused multiply-add. With FMA available (-march=native on most x86
+// machines) GCC contracts a * b + c into one FMA within an expression, which it does in the raw kernel but not across
+// the inlined Quantity operators, so the last bit of some results differs. The speed is unaffected; for a bitwise
+// comparison on such a build, add -ffp-contract=off.
+//
+// Build: g++ -std=c++20 -O2 units_benchmark.cpp -o units_benchmark
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "headers/units.h"
+
+using namespace unit_literals;
+
+// s = u t + 1/2 a t^2 and v = u + a t on raw floats
+__attribute__((noinline)) void raw_kernel(const float* u, const float* t, float a, float* v, float* s, std::size_t n) {
+    for (std::size_t i = 0; i < n; i++) {
+        v[i] = u[i] + a * t[i];
+        s[i] = u[i] * t[i] + 0.5f * a * t[i] * t[i];
+    }
+}
+
+// the same kernel written against the units layer
+__attribute__((noinline)) void units_kernel(const Velocity<float>* u, const Time<float>* t, Acceleration<float> a,
+                                            Velocity<float>* v, Length<float>* s, std::size_t n) {
+    for (std::size_t i = 0; i < n; i++) {
+        v[i] = suvat::final_velocity(u[i], a, t[i]);
+        s[i] = suvat::displacement(u[i], a, t[i]);
+    }
+}
+
+// constants fold at compile time: both of these are checked by the compiler, not at runtime
+constexpr Velocity<float> v_after_3s = suvat::final_velocity(0.0_mps, 9.81_mps2, 3.0_s);
+constexpr Time<float> time_to_30mps = suvat::time_to_reach(0.0_mps, 30.0_mps, 10.0_mps2);
+static_assert(v_after_3s.value() > 29.42f && v_after_3s.value() < 29.44f);
+static_assert(time_to_30mps.value() == 3.0f);
+
+// Uncommenting any of these is a compile error:
+// Length<float> wrong = 3.0_s;                  // time is not a length
+// auto also_wrong = 1.0_mps + 9.81_mps2;        // velocity + acceleration
+// Velocity<float> bad = suvat::displacement(0.0_mps, 9.81_mps2, 3.0_s);
+
+template <typename Kernel>
+double best_time(Kernel kernel, int repeats) {
+    double best = 1e300;
+    for (int r = 0; r < repeats; r++) {
+        auto start = std::chrono::steady_clock::now();
+        kernel();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(end - start).count());
+    }
+    return best;
+}
+
+int main() {
+    std::cout << "Units layer benchmark: raw float vs Quantity types." << std::endl;
+
+    const std::size_t n = 1 << 22;
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> dist(0.0f, 10.0f);
+    std::vector<float> u(n), t(n), v(n), s(n);
+    std::vector<Velocity<float>> qu(n), qv(n);
+    std::vector<Time<float>> qt(n);
+    std::vector<Length<float>> qs(n);
+    for (std::size_t i = 0; i < n; i++) {
+        u[i] = dist(rng);
+        t[i] = dist(rng);
+        qu[i] = Velocity<float>(u[i]);
+        qt[i] = Time<float>(t[i]);
+    }
+
+    const int repeats = 20;
+    double raw = best_time([&] { raw_kernel(u.data(), t.data(), 9.81f, v.data(), s.data(), n); }, repeats);
+    double typed = best_time([&] { units_kernel(qu.data(), qt.data(), 9.81_mps2, qv.data(), qs.data(), n); }, repeats);
+
+    bool identical = true;
+    for (std::size_t i = 0; i < n; i++) {
+        identical = identical && v[i] == qv[i].value() && s[i] == qs[i].value();
+    }
+
+    std::cout << "Elements: " << n << ", best of " << repeats << std::endl;
+    std::cout << "raw float:  " << raw * 1e3 << " ms (" << n / raw / 1e9 << " G elements/s)" << std::endl;
+    std::cout << "units:      " << typed * 1e3 << " ms (" << n / typed / 1e9 << " G elements/s)" << std::endl;
+    std::cout << "ratio:      " << typed / raw << std::endl;
+    std::cout << "Results bitwise identical: " << (identical ? "yes" : "no (FMA contraction, see the header)")
+              << std::endl;
+    std::cout << "Compile-time v after 3 s: " << v_after_3s.value() << "m/s" << std::endl;
+    return 0;
+}
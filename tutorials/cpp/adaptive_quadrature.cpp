@@ -0,0 +1,80 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+#include "headers/gauss_kronrod.h"
+#include "headers/quadrature.h"
+
+// Build: g++ -std=c++20 -O2 adaptive_quadrature.cpp -o adaptive_quadrature
+
+float continuous_function(float x, float m, float c) {
+    return m * x + c;
+}
+
+struct TestIntegral {
+    std::string name;
+    double (*f)(double);
+    double a, b, exact;
+};
+
+double peak(double x) { return 1.0 / ((x - 0.3) * (x - 0.3) + 1e-4); }
+double root(double x) { return std::sqrt(x); }
+double ripple(double x) { return std::exp(-x) * std::sin(50.0 * x); }
+
+template <typename Fn>
+double seconds(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+int main() {
+    std::cout << "Adaptive Gauss-Kronrod Quadrature" << std::endl;
+    std::cout << "The fixed Riemann loop spends the same work everywhere; an adaptive rule splits only where the error is." << std::endl;
+
+    // the tutorial's straight line is integrated exactly by a single Kronrod rule
+    AdaptiveResult line = integrate_adaptive([](double x) { return continuous_function(x, -1, 0); }, 5.0, 0.0, 1e-10);
+    std::cout << "\ny = -x from 5 to 0: " << line.value << " with " << line.evaluations << " evaluations" << std::endl;
+
+    const double pi = std::acos(-1.0);
+    TestIntegral tests[] = {
+        {"1 / ((x - 0.3)^2 + 1e-4) on [0, 1]", peak, 0.0, 1.0, 100.0 * (std::atan(70.0) + std::atan(30.0))},
+        {"sqrt(x) on [0, 1]", root, 0.0, 1.0, 2.0 / 3.0},
+        {"exp(-x) sin(50 x) on [0, pi]", ripple, 0.0, pi, 50.0 * (1.0 - std::exp(-pi)) / 2501.0},
+    };
+
+    for (const TestIntegral& test : tests) {
+        std::cout << "\n" << test.name << std::endl;
+        std::cout << "relative tolerance   G7-K15: evals  error  us   G10-K21: evals  error  us   Simpson: evals  error  us"
+                  << std::endl;
+        for (double tol : {1e-4, 1e-6, 1e-8, 1e-10, 1e-12}) {
+            std::cout << tol;
+            for (GaussKronrod rule : {GaussKronrod::g7_k15, GaussKronrod::g10_k21}) {
+                AdaptiveResult r;
+                double time = seconds([&] { r = integrate_adaptive(test.f, test.a, test.b, 0.0, tol, rule); });
+                std::cout << "\t" << r.evaluations << "\t" << std::abs(r.value - test.exact) / std::abs(test.exact) << "\t"
+                          << time * 1e6;
+            }
+            // uniform Simpson: double the partitions until the true relative error meets the tolerance
+            std::size_t n = 2;
+            double error = 0.0, time = 0.0;
+            for (; n <= (std::size_t(1) << 26); n *= 2) {
+                double value = 0.0;
+                time = seconds([&] { value = integrate<Rule::simpson>(test.f, test.a, test.b, n); });
+                error = std::abs(value - test.exact) / std::abs(test.exact);
+                if (error <= tol) {
+                    break;
+                }
+            }
+            if (error <= tol) {
+                std::cout << "\t" << n + 1 << "\t" << error << "\t" << time * 1e6 << std::endl;
+            } else {
+                std::cout << "\tnot reached with " << (n / 2) + 1 << " evaluations" << std::endl;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "headers/all_roots.h"
+#include "headers/roots.h"
+
+// Build: g++ -std=c++20 -O3 -march=native -pthread all_roots.cpp -o all_roots
+
+// root_finding_methods.cpp's cubic, expanded: m (x - 3)^3 + c = m x^3 - 9m x^2 + 27m x + (c - 27m)
+std::vector<double> cubic_coefficients(double m, double c) {
+    return {c - 27 * m, 27 * m, -9 * m, m};
+}
+
+// coefficients of (x - r_0)(x - r_1)..., lowest order first
+std::vector<double> from_roots(const std::vector<double>& roots) {
+    std::vector<double> p{1.0};
+    for (double r : roots) {
+        p.push_back(0.0);
+        for (std::size_t k = p.size() - 1; k > 0; k--) {
+            p[k] = p[k - 1] - r * p[k];
+        }
+        p[0] *= -r;
+    }
+    return p;
+}
+
+int main() {
+    std::cout << "All Roots -- bracket scanning and polynomial root finding\n" << std::endl;
+    const RootCriteria<double> criteria{1e-12, 0.0, 200};
+
+    // every root of sin(x) - x/10 on [-20, 20], with no bracket given
+    std::atomic<long> evaluations{0};
+    auto wave = [&](double x) {
+        evaluations++;
+        return std::sin(x) - x / 10;
+    };
+    std::vector<double> found = find_all_roots(wave, -20.0, 20.0, 4000, criteria);
+    std::cout << "sin(x) - x/10 on [-20, 20]: " << found.size() << " roots from " << evaluations.load()
+              << " evaluations (4001 for the scan)" << std::endl;
+    std::cout << std::setprecision(12);
+    for (double r : found) {
+        std::cout << "  x = " << std::setw(16) << r << "   f(x) = " << std::sin(r) - r / 10 << std::endl;
+    }
+    std::cout << std::setprecision(6);
+
+    // the tutorial's cubic: one real root and a complex pair, without guessing an interval
+    const double m = -2, c = 5;
+    PolynomialRoots<double> cubic = polynomial_roots(cubic_coefficients(m, c));
+    std::cout << "\n-2(x-3)^3 + 5 by Aberth-Ehrlich (" << cubic.iterations << " sweeps, "
+              << (cubic.converged ? "converged" : "not converged") << "):" << std::endl;
+    std::cout << std::setprecision(12);
+    for (const std::complex<double>& z : cubic.roots) {
+        std::cout << "  " << z.real() << (z.imag() < 0 ? " - " : " + ") << std::abs(z.imag()) << "i" << std::endl;
+    }
+    std::vector<double> real = real_polynomial_roots(cubic_coefficients(m, c));
+    std::cout << "  real root " << real.at(0) << ", exact 3 + cbrt(2.5) = " << 3 + std::cbrt(2.5) << std::endl;
+    std::cout << std::setprecision(6);
+
+    // higher degree: Chebyshev T_16 has 16 real roots clustered towards +-1
+    std::vector<double> chebyshev_roots;
+    const int n = 16;
+    for (int k = 1; k <= n; k++) {
+        chebyshev_roots.push_back(std::cos((2 * k - 1) * M_PI / (2 * n)));
+    }
+    const std::vector<double> chebyshev = from_roots(chebyshev_roots);
+    const std::vector<double> solved = real_polynomial_roots(chebyshev);
+    double worst = 0;
+    for (std::size_t k = 0; k < solved.size(); k++) {
+        worst = std::max(worst, std::abs(solved[k] - chebyshev_roots[solved.size() - 1 - k]));
+    }
+    std::cout << "\nChebyshev T_16: " << solved.size() << " real roots, largest error " << worst << std::endl;
+
+    // many cubics: Aberth versus bracketing [1, 200] and bisecting, as the tutorial did
+    const int solves = 100'000;
+    double checksum = 0;
+    long bisection_evaluations = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int k = 0; k < solves; k++) {
+        checksum += real_polynomial_roots(cubic_coefficients(m, 5.0 + 0.001 * (k % 1000))).at(0);
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for (int k = 0; k < solves; k++) {
+        const double ck = 5.0 + 0.001 * (k % 1000);
+        RootResult<double> r = bisection([&](double x) { return m * (x - 3) * (x - 3) * (x - 3) + ck; }, 1.0, 200.0,
+                                         criteria);
+        checksum -= r.root;
+        bisection_evaluations += r.evaluations;
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "\n" << solves << " cubics:" << std::endl;
+    std::cout << "  Aberth + Newton polish  " << std::chrono::duration<double, std::nano>(middle - start).count() / solves
+              << " ns/solve" << std::endl;
+    std::cout << "  bisection on [1, 200]   " << std::chrono::duration<double, std::nano>(end - middle).count() / solves
+              << " ns/solve, " << double(bisection_evaluations) / solves << " evaluations" << std::endl;
+    std::cout << "  mean difference " << checksum / solves << std::endl;
+    return 0;
+}
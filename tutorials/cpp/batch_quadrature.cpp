@@ -0,0 +1,66 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include "headers/batch_quadrature.h"
+#include "headers/quadrature.h"
+
+// Build: g++ -std=c++20 -O3 -march=native batch_quadrature.cpp -o batch_quadrature
+
+float continuous_function(float x, float m, float c) {
+    return m * x + c;
+}
+
+template <typename Fn>
+double seconds(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+template <typename Fn>
+void report(const char* name, std::size_t points, Fn&& fn) {
+    volatile float area = 0.0f;
+    double time = seconds([&] { area = fn(); });
+    std::cout << name << "\t" << area << "\t" << points / time / 1e9 << " G points/s\t"
+              << points * sizeof(float) / time / 1e9 << " GB/s of y" << std::endl;
+}
+
+int main() {
+    std::cout << "Batched SIMD Quadrature" << std::endl;
+    std::cout << "Integrands are evaluated a block at a time and the blocks are summed pairwise." << std::endl;
+
+    const float m = -1, c = 0, x_0 = 5, x_T = 0;
+    auto line = [m, c](float x) { return continuous_function(x, m, c); };
+    const LinearIntegrand<float> simd_line{m, c};
+    // 0.1 x^3 - x^2 + 2 x + 1
+    auto cubic = [](float x) { return ((0.1f * x - 1.0f) * x + 2.0f) * x + 1.0f; };
+    const PolynomialIntegrand<float> simd_cubic{{1.0f, 2.0f, -1.0f, 0.1f}};
+    const double cubic_exact = -(0.025 * 625 - 125.0 / 3 + 25 + 5);  // from 5 down to 0
+
+    // accuracy of a float accumulator as the partition count grows
+    std::cout << "\nLeft-point area of y = -x from 5 to 0 (exact 12.5), float throughout" << std::endl;
+    std::cout << "partitions   sequential sum   pairwise sum" << std::endl;
+    for (std::size_t n : {1000, 100000, 10000000, 100000000}) {
+        std::cout << n << "\t" << integrate<Rule::left>(line, x_0, x_T, n) << "\t"
+                  << integrate_batched<Rule::left>(simd_line, x_0, x_T, n) << std::endl;
+    }
+
+    const std::size_t n = 100'000'000;
+    std::cout << "\nThroughput, " << n << " partitions" << std::endl;
+    report("linear, scalar integrate       ", n, [&] { return integrate<Rule::left>(line, x_0, x_T, n); });
+    report("linear, batched scalar functor ", n, [&] { return integrate_batched<Rule::left>(scalar_batch(line), x_0, x_T, n); });
+    report("linear, batched SIMD           ", n, [&] { return integrate_batched<Rule::left>(simd_line, x_0, x_T, n); });
+    report("linear, batched SIMD simpson   ", n, [&] { return integrate_batched<Rule::simpson>(simd_line, x_0, x_T, n); });
+    report("cubic, scalar integrate        ", n, [&] { return integrate<Rule::left>(cubic, x_0, x_T, n); });
+    report("cubic, batched SIMD            ", n, [&] { return integrate_batched<Rule::left>(simd_cubic, x_0, x_T, n); });
+    std::cout << "cubic exact: " << cubic_exact << std::endl;
+
+    // memory speed reference: a pairwise sum over an array that does not fit in cache
+    std::vector<float> big(32'000'000, 1.0f);
+    report("reference: sum of a 128 MB array", big.size(), [&] { return pairwise_sum(big.data(), big.size()); });
+    return 0;
+}
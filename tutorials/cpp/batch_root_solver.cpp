@@ -0,0 +1,98 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "headers/batch_roots.h"
+#include "headers/roots.h"
+
+// Build: g++ -std=c++20 -O3 -march=native -pthread batch_root_solver.cpp -o batch_root_solver
+
+// root_finding_methods.cpp's function with per-equation m and c; works on scalars and on simd vectors
+auto continuous_function = [](auto x, const auto& p) {
+    auto u = x - 3;
+    return p[0] * u * u * u + p[1];
+};
+auto continuous_slope = [](auto x, const auto& p) {
+    auto u = x - 3;
+    return 3 * p[0] * u * u;
+};
+
+int main() {
+    std::cout << "Batched Root Solver" << std::endl;
+    std::cout << "Solves m (x - 3)^3 + c = 0 for millions of (m, c) pairs, simd lanes at a time." << std::endl;
+
+    const std::size_t n = 4'000'000;
+    std::vector<double> m(n), c(n), lo(n, 1.0), hi(n, 200.0), guess(n, 10.0), exact(n), roots(n);
+    std::vector<unsigned char> converged(n);
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> slope(-3.0, -1.0), offset(1.0, 10.0);
+    for (std::size_t i = 0; i < n; i++) {
+        m[i] = slope(rng);
+        c[i] = offset(rng);
+        exact[i] = 3 + std::cbrt(-c[i] / m[i]);
+    }
+    const ParameterArrays<2, double> parameters{std::span<const double>(m), std::span<const double>(c)};
+    const RootCriteria<double> criteria{1e-12, 0.0, 200};
+
+    auto report = [&](const char* name, double seconds, std::size_t ok) {
+        double worst = 0.0;
+        for (std::size_t i = 0; i < n; i++) {
+            worst = std::max(worst, std::abs(roots[i] - exact[i]));
+        }
+        std::cout << std::left << std::setw(36) << name << std::right << std::setw(10) << n / seconds / 1e6
+                  << std::setw(12) << ok << std::setw(14) << worst << std::endl;
+    };
+    auto time = [](auto&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        auto result = fn();
+        return std::make_pair(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(),
+                              result);
+    };
+
+    std::cout << "\n" << n << " equations, tolerance 1e-12, " << simd<double>::lanes << " lanes per group"
+              << std::endl;
+    std::cout << "method                              M solves/s   converged     max error" << std::endl;
+    auto [scalar_seconds, scalar_ok] = time([&] {
+        std::size_t ok = 0;
+        for (std::size_t i = 0; i < n; i++) {
+            const std::array<double, 2> p{m[i], c[i]};
+            RootResult<double> r = newton([&](double x) { return continuous_function(x, p); },
+                                          [&](double x) { return continuous_slope(x, p); }, guess[i], criteria);
+            roots[i] = r.root;
+            ok += r.converged ? 1 : 0;
+        }
+        return ok;
+    });
+    report("scalar newton (roots.h), 1 thread", scalar_seconds, scalar_ok);
+
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads : {1u, cores}) {
+        BatchRootOptions options;
+        options.threads = threads;
+        std::string suffix = ", " + std::to_string(threads) + (threads == 1 ? " thread" : " threads");
+        auto [s1, ok1] = time([&] {
+            return newton_batch<2, double>(continuous_function, continuous_slope, parameters, guess, roots, criteria,
+                                           converged, options);
+        });
+        report(("newton_batch" + suffix).c_str(), s1, ok1);
+        auto [s2, ok2] = time([&] {
+            return safeguarded_newton_batch<2, double>(continuous_function, continuous_slope, parameters, lo, hi,
+                                                       guess, roots, criteria, converged, options);
+        });
+        report(("safeguarded_newton_batch" + suffix).c_str(), s2, ok2);
+        auto [s3, ok3] = time([&] {
+            return bisection_batch<2, double>(continuous_function, parameters, lo, hi, roots, criteria, converged,
+                                              options);
+        });
+        report(("bisection_batch" + suffix).c_str(), s3, ok3);
+        if (cores == 1) {
+            break;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+#include "headers/batch_quadrature.h"
+#include "headers/expression.h"
+#include "headers/quadrature.h"
+#include "headers/roots.h"
+
+// Build: g++ -std=c++20 -O3 -march=native expression_integrands.cpp -o expression_integrands
+
+// The integrand of riemann_integral.cpp and the root-finding target of root_finding_methods.cpp, written by hand.
+float continuous_function(float x, float m, float c) {
+    return m * x + c;
+}
+
+float cubic_function(float x, float m, float c) {
+    return m * (x - 3) * (x - 3) * (x - 3) + c;
+}
+
+// The same formulas as expressions, checked at compile time.
+constexpr Variable x;
+static_assert((-1.0 * x + 0.0)(5.0) == -5.0);
+static_assert(derivative(-2.0 * pow<3>(x - 3) + 5.0)(4.0) == -6.0);
+
+template <typename Fn>
+void report(const char* name, std::size_t points, Fn&& fn) {
+    volatile float area = 0.0f;
+    auto start = std::chrono::steady_clock::now();
+    area = fn();
+    auto end = std::chrono::steady_clock::now();
+    double time = std::chrono::duration<double>(end - start).count();
+    std::cout << name << "\t" << area << "\t" << points / time / 1e9 << " G points/s" << std::endl;
+}
+
+int main() {
+    std::cout << "Expression Template Integrands" << std::endl;
+    std::cout << "Formulas written as expressions compile to fused kernels with symbolic derivatives." << std::endl;
+
+    const float m = -1, c = 0, x_0 = 5, x_T = 0;
+    auto line = m * x + c;
+    auto line_slope = derivative(line);
+    std::cout << "\ny = m x + c with m = " << m << ", c = " << c << std::endl;
+    std::cout << "y(2) = " << line(2.0f) << " (hand-written: " << continuous_function(2.0f, m, c)
+              << "), dy/dx = " << line_slope(2.0f) << std::endl;
+
+    const float cubic_m = -2, cubic_c = 5;
+    auto cubic = cubic_m * pow<3>(x - 3) + cubic_c;
+    auto cubic_slope = derivative(cubic);
+    std::cout << "\ny = m (x - 3)^3 + c with m = " << cubic_m << ", c = " << cubic_c << std::endl;
+    std::cout << "y(4) = " << cubic(4.0f) << " (hand-written: " << cubic_function(4.0f, cubic_m, cubic_c)
+              << "), dy/dx = " << cubic_slope(4.0f) << std::endl;
+    RootResult<double> root = newton(cubic, cubic_slope, 10.0, 1e-12);
+    std::cout << "Newton with the symbolic derivative: root " << root.root << " after " << root.iterations
+              << " iterations (exact " << 3 + std::cbrt(2.5) << ")" << std::endl;
+
+    // the expression is a batch integrand, evaluated a vector at a time; every row sums pairwise, as the batched
+    // integrator does, so the rows differ only in how the integrand is evaluated
+    const std::size_t n = 100'000'000;
+    auto hand_line = [m, c](float v) { return continuous_function(v, m, c); };
+    auto hand_cubic = [cubic_m, cubic_c](float v) { return cubic_function(v, cubic_m, cubic_c); };
+    std::cout << "\nLeft-point areas from 5 to 0, " << n << " partitions" << std::endl;
+    report("line, hand-written scalar ", n, [&] { return integrate<Rule::left, PairwiseSum>(hand_line, x_0, x_T, n); });
+    report("line, hand-written SIMD   ", n,
+           [&] { return integrate_batched<Rule::left>(LinearIntegrand<float>{m, c}, x_0, x_T, n); });
+    report("line, expression batched  ", n, [&] { return integrate_batched<Rule::left>(line, x_0, x_T, n); });
+    report("cubic, hand-written batched", n,
+           [&] { return integrate_batched<Rule::left>(scalar_batch(hand_cubic), x_0, x_T, n); });
+    report("cubic, expression batched ", n, [&] { return integrate_batched<Rule::left>(cubic, x_0, x_T, n); });
+    std::cout << "exact areas: 12.5 and " << -(cubic_m * (std::pow(2.0, 4) - std::pow(-3.0, 4)) / 4 + cubic_c * 5)
+              << std::endl;
+    return 0;
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+// Summation policies for the integration engine. Each is a small class with add(value) and total(), passed to
+// integrate() as a template template parameter:
+//
+//   integrate<Rule::left, KahanSum>(f, 0.0f, 1.0f, 1000000000);
+//
+//   NaiveSum     - one running sum; error grows with n, useless in float beyond ~1e7 terms
+//   KahanSum     - carries the rounding error of each addition in a second variable; error independent of n as
+//                  long as the terms are smaller than the running sum
+//   NeumaierSum  - Kahan with the compensation chosen by magnitude, so it also survives terms larger than the sum.
+//                  Its compensation is itself a plain sum, though: once the terms fall below the running sum's
+//                  rounding step (about 2^24 terms in float) they all pile into it and the accuracy goes with them
+//   PairwiseSum  - adds terms in blocks and combines block sums as a balanced tree; O(log n) error growth, and the
+//                  block loop vectorises, unlike the compensated sums whose steps depend on each other
+//
+// The compensated sums rely on exact IEEE evaluation order: do not build them with -ffast-math, which lets the
+// compiler simplify the compensation away.
+
+template <typename Real>
+class NaiveSum {
+public:
+    constexpr void add(Real value) { sum += value; }
+    constexpr Real total() const { return sum; }
+
+private:
+    Real sum = 0;
+};
+
+template <typename Real>
+class KahanSum {
+public:
+    constexpr void add(Real value) {
+        Real y = value - compensation;
+        Real t = sum + y;
+        compensation = (t - sum) - y;
+        sum = t;
+    }
+    constexpr Real total() const { return sum; }
+
+private:
+    Real sum = 0;
+    Real compensation = 0;
+};
+
+template <typename Real>
+class NeumaierSum {
+public:
+    constexpr void add(Real value) {
+        Real t = sum + value;
+        if ((sum < 0 ? -sum : sum) >= (value < 0 ? -value : value)) {
+            compensation += (sum - t) + value;
+        } else {
+            compensation += (value - t) + sum;
+        }
+        sum = t;
+    }
+    constexpr Real total() const { return sum + compensation; }
+
+private:
+    Real sum = 0;
+    Real compensation = 0;
+};
+
+// Running pairwise combination of block sums: block k is merged like a binary counter, so every sum of 2^j blocks
+// is formed from two sums of 2^(j-1) blocks, the same tree a recursive pairwise sum would build over the range.
+template <typename Real>
+class PairwiseAccumulator {
+public:
+    constexpr void add(Real block_sum) {
+        Real carry = block_sum;
+        std::size_t level = 0;
+        for (std::size_t count = blocks; count & 1; count >>= 1, level++) {
+            carry = levels[level] + carry;
+        }
+        if (level == levels.size()) {
+            levels.push_back(carry);
+        } else {
+            levels[level] = carry;
+        }
+        blocks++;
+    }
+
+    constexpr Real total() const {
+        Real sum = 0;
+        for (std::size_t level = 0; level < levels.size(); level++) {
+            if ((blocks >> level) & 1) {
+                sum += levels[level];
+            }
+        }
+        return sum;
+    }
+
+private:
+    std::vector<Real> levels;
+    std::size_t blocks = 0;
+};
+
+template <typename Real>
+class PairwiseSum {
+public:
+    constexpr void add(Real value) {
+        buffer[fill++] = value;
+        if (fill == block) {
+            flush();
+        }
+    }
+
+    constexpr Real total() const {
+        PairwiseSum copy = *this;
+        copy.flush();
+        return copy.blocks.total();
+    }
+
+private:
+    static constexpr std::size_t block = 256;
+    std::array<Real, block> buffer{};
+    std::size_t fill = 0;
+    PairwiseAccumulator<Real> blocks;
+
+    // eight interleaved partial sums within the block, then a tree over the eight
+    constexpr void flush() {
+        if (fill == 0) {
+            return;
+        }
+        Real lane[8] = {};
+        std::size_t i = 0;
+        for (; i + 8 <= fill; i += 8) {
+            for (int k = 0; k < 8; k++) {
+                lane[k] += buffer[i + k];
+            }
+        }
+        for (; i < fill; i++) {
+            lane[i % 8] += buffer[i];
+        }
+        blocks.add(((lane[0] + lane[1]) + (lane[2] + lane[3])) + ((lane[4] + lane[5]) + (lane[6] + lane[7])));
+        fill = 0;
+    }
+};
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <numbers>
+#include <thread>
+#include <vector>
+
+#include "parallel_chunks.h"
+#include "roots.h"
+
+// Finding every root instead of the one inside a known bracket.
+//
+// scan_brackets samples f on a uniform grid over [lo, hi] and returns each grid interval where f changes sign (or
+// hits zero), in order. The grid is split into chunks scanned on separate threads, each chunk starting on the last
+// point of the previous one so no interval is skipped. find_all_roots refines every bracket with Brent's method.
+// A scan only sees roots where f changes sign between grid points: a double root, or two roots closer than the grid
+// spacing, is missed, so choose the sample count for the finest feature of f.
+//
+// Polynomials need no scan. polynomial_roots finds all n complex roots of a degree-n polynomial at once by the
+// Aberth-Ehrlich iteration, which moves each estimate by its Newton correction deflected away from the others:
+//
+//   w_k = (p/p')(z_k) / (1 - (p/p')(z_k) sum_{j != k} 1/(z_k - z_j))
+//
+// converging cubically for simple roots (linearly for repeated ones). Starting points sit on a circle whose radius
+// bounds every root. real_polynomial_roots keeps the roots with negligible imaginary part and polishes them with
+// Newton on the real polynomial.
+//
+// Coefficients are stored lowest order first, as in PolynomialIntegrand.
+
+template <typename Real>
+struct Bracket {
+    Real lo, hi;
+};
+
+template <typename Real, typename F>
+std::vector<Bracket<Real>> scan_brackets(F&& f, Real lo, Real hi, std::size_t intervals,
+                                         unsigned threads = std::max(1u, std::thread::hardware_concurrency())) {
+    intervals = std::max<std::size_t>(intervals, 1);
+    const Real h = (hi - lo) / static_cast<Real>(intervals);
+    auto grid = [&](std::size_t i) { return i == intervals ? hi : lo + static_cast<Real>(i) * h; };
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>((intervals + 1023) / 1024)));
+    std::vector<std::vector<Bracket<Real>>> found(threads);
+    parallel_chunks(threads, threads, [&](std::size_t t) {
+        const std::size_t first = intervals * t / threads, last = intervals * (t + 1) / threads;
+        Real x0 = grid(first);
+        Real f0 = f(x0);
+        for (std::size_t i = first + 1; i <= last; i++) {
+            const Real x1 = grid(i);
+            const Real f1 = f(x1);
+            // a zero on a grid point belongs to the interval ending there, so it is reported once
+            if ((f0 < 0 && f1 >= 0) || (f0 > 0 && f1 <= 0) || (i == first + 1 && first == 0 && f0 == 0)) {
+                found[t].push_back({x0, x1});
+            }
+            x0 = x1;
+            f0 = f1;
+        }
+    });
+    std::vector<Bracket<Real>> brackets;
+    for (const auto& part : found) {
+        brackets.insert(brackets.end(), part.begin(), part.end());
+    }
+    return brackets;
+}
+
+template <typename Real, typename F>
+std::vector<Real> find_all_roots(F&& f, Real lo, Real hi, std::size_t intervals, const RootCriteria<Real>& criteria,
+                                 unsigned threads = std::max(1u, std::thread::hardware_concurrency())) {
+    std::vector<Real> roots;
+    for (const Bracket<Real>& b : scan_brackets(f, lo, hi, intervals, threads)) {
+        RootResult<Real> r = brent(f, b.lo, b.hi, criteria);
+        if (r.converged) {
+            roots.push_back(r.root);
+        }
+    }
+    return roots;
+}
+
+// p(x) and p'(x) by Horner's scheme, for real or complex x.
+template <typename Real, typename X>
+void evaluate_polynomial(const std::vector<Real>& coefficients, X x, X& value, X& slope) {
+    value = X(coefficients.back());
+    slope = X(0);
+    for (std::size_t k = coefficients.size() - 1; k-- > 0;) {
+        slope = slope * x + value;
+        value = value * x + X(coefficients[k]);
+    }
+}
+
+template <typename Real>
+struct PolynomialRoots {
+    std::vector<std::complex<Real>> roots;
+    int iterations = 0;
+    bool converged = false;
+};
+
+template <typename Real>
+PolynomialRoots<Real> polynomial_roots(std::vector<Real> coefficients, Real tolerance = Real(1e-14),
+                                       int max_iterations = 500) {
+    using Complex = std::complex<Real>;
+    PolynomialRoots<Real> result;
+    while (coefficients.size() > 1 && coefficients.back() == 0) {
+        coefficients.pop_back();  // the true degree
+    }
+    const std::size_t degree = coefficients.size() - 1;
+    if (degree == 0) {
+        result.converged = true;
+        return result;
+    }
+    // Fujiwara's bound: every root lies within 2 max |a_{n-k} / a_n|^(1/k)
+    Real radius = 0;
+    for (std::size_t k = 1; k <= degree; k++) {
+        Real ratio = std::abs(coefficients[degree - k] / coefficients[degree]);
+        if (k == degree) {
+            ratio /= 2;
+        }
+        radius = std::max(radius, std::pow(ratio, Real(1) / static_cast<Real>(k)));
+    }
+    radius = radius > 0 ? 2 * radius : Real(1);
+    // start on the circle, turned off the real axis so conjugate pairs are not started symmetric
+    std::vector<Complex>& z = result.roots;
+    z.resize(degree);
+    for (std::size_t k = 0; k < degree; k++) {
+        const Real turn = (static_cast<Real>(k) + Real(0.25)) / static_cast<Real>(degree);
+        const Real angle = 2 * std::numbers::pi_v<Real> * turn + Real(0.4);
+        z[k] = std::polar(radius / 2, angle);
+    }
+    std::vector<bool> settled(degree, false);
+    for (result.iterations = 1; result.iterations <= max_iterations; result.iterations++) {
+        std::size_t moving = 0;
+        for (std::size_t k = 0; k < degree; k++) {
+            if (settled[k]) {
+                continue;
+            }
+            Complex value, slope;
+            evaluate_polynomial(coefficients, z[k], value, slope);
+            if (value == Complex(0)) {
+                settled[k] = true;
+                continue;
+            }
+            const Complex ratio = value / slope;
+            Complex repulsion = 0;
+            for (std::size_t j = 0; j < degree; j++) {
+                if (j != k) {
+                    repulsion += Real(1) / (z[k] - z[j]);
+                }
+            }
+            const Complex w = ratio / (Real(1) - ratio * repulsion);
+            z[k] -= w;  // Gauss-Seidel: later roots in this sweep already see the update
+            if (std::abs(w) <= tolerance * std::max(std::abs(z[k]), Real(1))) {
+                settled[k] = true;
+            } else {
+                moving++;
+            }
+        }
+        if (moving == 0) {
+            result.converged = true;
+            break;
+        }
+    }
+    result.iterations = std::min(result.iterations, max_iterations);
+    return result;
+}
+
+// Real roots in increasing order: complex roots within imaginary_tolerance (relative) of the axis, polished by Newton.
+template <typename Real>
+std::vector<Real> real_polynomial_roots(const std::vector<Real>& coefficients, Real imaginary_tolerance = Real(1e-8)) {
+    std::vector<Real> real;
+    for (const std::complex<Real>& z : polynomial_roots(coefficients).roots) {
+        if (std::abs(z.imag()) > imaginary_tolerance * std::max(std::abs(z), Real(1))) {
+            continue;
+        }
+        Real x = z.real();
+        for (int iteration = 0; iteration < 3; iteration++) {
+            Real value, slope;
+            evaluate_polynomial(coefficients, x, value, slope);
+            if (slope == 0) {
+                break;
+            }
+            x -= value / slope;
+        }
+        real.push_back(x);
+    }
+    std::sort(real.begin(), real.end());
+    return real;
+}
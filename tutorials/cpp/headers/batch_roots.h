@@ -0,0 +1,212 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "batch_quadrature.h"
+#include "parallel_chunks.h"
+#include "roots.h"
+
+// Batched root finding for many independent equations of one family, such as continuous_function(x, m, c) from
+// root_finding_methods.cpp with a different m and c per equation.
+//
+// A family is a callable f(x, p) where x is a scalar or a simd<Real> vector and p is a std::array of P parameters of
+// the same type; lane k of the vectors is equation k of the current group:
+//
+//   auto cubic = [](auto x, const auto& p) { return p[0] * (x - 3) * (x - 3) * (x - 3) + p[1]; };
+//   newton_batch<2, double>(cubic, cubic_slope, {m, c}, x0, roots, criteria);
+//
+// Each group of simd lanes iterates together. Lanes that have converged (or failed) are masked: their x stops
+// changing while the others continue, and the group finishes when every lane is done. The groups are cut into
+// chunks which threads take from a shared counter. Nothing is allocated per equation.
+//
+//   bisection_batch           - per-equation bracket [lo, hi]
+//   newton_batch              - per-equation starting guess, with the family's derivative
+//   safeguarded_newton_batch  - Newton inside a bracket, falling back to bisection whenever a step leaves it
+//
+// Each returns the number of converged equations, and fills converged (if not empty) with a flag per equation.
+
+struct BatchRootOptions {
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t chunk = 4096;  // equations per work item
+};
+
+namespace batch_roots_detail {
+
+template <typename Vec>
+Vec absolute(Vec v) {
+    return v < 0 ? -v : v;
+}
+
+template <typename Mask>
+bool any(Mask m) {
+    for (std::size_t k = 0; k < sizeof(Mask) / sizeof(m[0]); k++) {
+        if (m[k]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Lanes [first, first + lanes) of an array, padded with the last element past its end.
+template <typename Real>
+typename simd<Real>::type load_padded(std::span<const Real> values, std::size_t first) {
+    constexpr std::size_t lanes = simd<Real>::lanes;
+    if (first + lanes <= values.size()) {
+        return simd_load(&values[first]);
+    }
+    typename simd<Real>::type v;
+    for (std::size_t k = 0; k < lanes; k++) {
+        v[k] = values[std::min(first + k, values.size() - 1)];
+    }
+    return v;
+}
+
+// Runs group(first) for each simd-width group of n equations on the requested threads; returns the summed results.
+template <typename Real, typename Group>
+std::size_t run_groups(std::size_t n, const BatchRootOptions& options, Group&& group) {
+    constexpr std::size_t lanes = simd<Real>::lanes;
+    const std::size_t chunk = std::max(lanes, options.chunk / lanes * lanes);
+    const std::size_t chunks = (n + chunk - 1) / chunk;
+    std::atomic<std::size_t> converged{0};
+    parallel_chunks(chunks, options.threads, [&](std::size_t c) {
+        std::size_t mine = 0;
+        for (std::size_t first = c * chunk; first < std::min(n, (c + 1) * chunk); first += lanes) {
+            mine += group(first);
+        }
+        converged.fetch_add(mine, std::memory_order_relaxed);
+    });
+    return converged.load();
+}
+
+// Stores the valid lanes of a group's roots and flags; returns how many of them converged.
+template <typename Real, typename Vec, typename Mask>
+std::size_t store_group(std::size_t first, Vec x, Mask done_ok, std::span<Real> roots,
+                        std::span<unsigned char> converged) {
+    std::size_t count = 0;
+    for (std::size_t k = 0; k < simd<Real>::lanes && first + k < roots.size(); k++) {
+        roots[first + k] = x[k];
+        if (!converged.empty()) {
+            converged[first + k] = done_ok[k] ? 1 : 0;
+        }
+        count += done_ok[k] ? 1 : 0;
+    }
+    return count;
+}
+
+}  // namespace batch_roots_detail
+
+template <std::size_t P, typename Real>
+using ParameterArrays = std::array<std::span<const Real>, P>;
+
+template <std::size_t P, typename Real, typename F>
+std::size_t bisection_batch(F&& f, const ParameterArrays<P, Real>& parameters, std::span<const Real> lo,
+                            std::span<const Real> hi, std::span<Real> roots, const RootCriteria<Real>& criteria,
+                            std::span<unsigned char> converged = {}, const BatchRootOptions& options = {}) {
+    using namespace batch_roots_detail;
+    using Vec = typename simd<Real>::type;
+    return run_groups<Real>(roots.size(), options, [&](std::size_t first) {
+        std::array<Vec, P> p;
+        for (std::size_t j = 0; j < P; j++) {
+            p[j] = load_padded(parameters[j], first);
+        }
+        Vec a = load_padded(lo, first), b = load_padded(hi, first);
+        Vec fa = f(a, p);
+        const Vec fb = f(b, p);
+        auto active = (fa < 0) != (fb < 0);  // lanes without a sign change fail at once
+        auto ok = (fa == 0) | (fb == 0);
+        Vec x = fa == 0 ? a : b;
+        active &= ~ok;
+        for (int iteration = 0; iteration < criteria.max_iterations && any(active); iteration++) {
+            const Vec mid = a + (b - a) / 2;
+            const Vec fm = f(mid, p);
+            const auto done = (absolute(fm) <= criteria.f_tolerance) | (absolute(b - a) / 2 < criteria.x_tolerance);
+            x = active ? mid : x;
+            ok |= active & done;
+            const auto left = (fm < 0) == (fa < 0);  // the root is above mid
+            a = (active & left) ? mid : a;
+            fa = (active & left) ? fm : fa;
+            b = (active & ~left) ? mid : b;
+            active &= ~done;
+        }
+        return store_group(first, x, ok, roots, converged);
+    });
+}
+
+template <std::size_t P, typename Real, typename F, typename DF>
+std::size_t newton_batch(F&& f, DF&& df, const ParameterArrays<P, Real>& parameters, std::span<const Real> x0,
+                         std::span<Real> roots, const RootCriteria<Real>& criteria,
+                         std::span<unsigned char> converged = {}, const BatchRootOptions& options = {}) {
+    using namespace batch_roots_detail;
+    using Vec = typename simd<Real>::type;
+    return run_groups<Real>(roots.size(), options, [&](std::size_t first) {
+        std::array<Vec, P> p;
+        for (std::size_t j = 0; j < P; j++) {
+            p[j] = load_padded(parameters[j], first);
+        }
+        Vec x = load_padded(x0, first);
+        auto active = x == x;  // every lane but those started from NaN, which fail
+        auto ok = active & ~active;
+        for (int iteration = 0; iteration < criteria.max_iterations && any(active); iteration++) {
+            const Vec fx = f(x, p);
+            const Vec slope = df(x, p);
+            const auto small = (fx == 0) | (absolute(fx) <= criteria.f_tolerance);
+            ok |= active & small;
+            active &= ~small & (slope != 0);  // a zero slope fails the lane
+            const Vec step = fx / slope;
+            x = active ? x - step : x;
+            const auto done = absolute(step) <= criteria.x_tolerance;
+            ok |= active & done;
+            active &= ~done;
+        }
+        return store_group(first, x, ok, roots, converged);
+    });
+}
+
+// Newton steps that stay inside the bracket, which shrinks around the root with every evaluation; a step that
+// would leave it is replaced by bisection. Converges whenever the bracket is valid.
+template <std::size_t P, typename Real, typename F, typename DF>
+std::size_t safeguarded_newton_batch(F&& f, DF&& df, const ParameterArrays<P, Real>& parameters,
+                                     std::span<const Real> lo, std::span<const Real> hi, std::span<const Real> x0,
+                                     std::span<Real> roots, const RootCriteria<Real>& criteria,
+                                     std::span<unsigned char> converged = {}, const BatchRootOptions& options = {}) {
+    using namespace batch_roots_detail;
+    using Vec = typename simd<Real>::type;
+    return run_groups<Real>(roots.size(), options, [&](std::size_t first) {
+        std::array<Vec, P> p;
+        for (std::size_t j = 0; j < P; j++) {
+            p[j] = load_padded(parameters[j], first);
+        }
+        Vec a = load_padded(lo, first), b = load_padded(hi, first);
+        const Vec fa = f(a, p);
+        Vec x = load_padded(x0, first);
+        auto active = x == x;
+        auto ok = active & ~active;
+        for (int iteration = 0; iteration < criteria.max_iterations && any(active); iteration++) {
+            const Vec fx = f(x, p);
+            const Vec slope = df(x, p);
+            const auto small = (fx == 0) | (absolute(fx) <= criteria.f_tolerance);
+            ok |= active & small;
+            active &= ~small;
+            // shrink the bracket to the side holding the root
+            const auto below = (fx < 0) == (fa < 0);  // the root is above x
+            a = (active & below) ? x : a;
+            b = (active & ~below) ? x : b;
+            // a Newton step within tolerance is taken as is: near the root, rounding can put it just outside the
+            // bracket, and bisecting there would throw away the converged estimate
+            const Vec step = fx / slope;
+            const auto done = (absolute(step) <= criteria.x_tolerance) | (absolute(b - a) <= criteria.x_tolerance);
+            const auto outside = ((x - step - a) * (x - step - b) > 0) | (slope == 0);
+            const Vec next = (outside & ~done) ? a + (b - a) / 2 : x - step;
+            x = active ? next : x;
+            ok |= active & done;
+            active &= ~done;
+        }
+        return store_group(first, x, ok, roots, converged);
+    });
+}
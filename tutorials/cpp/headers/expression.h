@@ -0,0 +1,408 @@
+#pragma once
+
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+#include "batch_quadrature.h"
+#include "roots.h"
+
+// Expression templates for integrands and root-finding targets (see "Expression Templates" in
+// documentation/c++/C++_QUANT_DEVELOPER_GUIDE.md). Writing
+//
+//   Variable x;
+//   auto f = m * x + c;
+//   auto g = m * pow<3>(x - 3) + c;
+//
+// builds a type whose structure is the formula, so calling f(2.0) compiles to the same code as the hand-written
+// m * 2.0 + c, with no virtual calls or heap nodes. Coefficients such as m and c are stored by value and may be
+// run-time values; the expression and its evaluation are constexpr when they are not.
+//
+// Every expression is
+//   - callable on a scalar, or on a GCC vector of scalars, which evaluates all lanes in one fused pass;
+//   - a batch integrand for integrate_batched (it has evaluate(x, y), which runs on simd<Real> vectors);
+//   - differentiable: derivative(f) is another expression, built at compile time by the usual rules, with
+//     zeros and ones folded away so the derivative of m * x + c is just m.
+//
+// exp, log, sin, cos and sqrt have no vector form, so on vectors they are applied lane by lane.
+//
+// newton(f, x0, criteria) and halley(f, x0, criteria) take their derivatives from the expression itself.
+
+template <typename E>
+struct Expression {
+    constexpr const E& self() const { return static_cast<const E&>(*this); }
+
+    // Batch interface of batch_quadrature.h: y[i] = f(x[i]), a vector of lanes at a time.
+    template <typename Real>
+    void evaluate(std::span<const Real> x, std::span<Real> y) const {
+        constexpr std::size_t lanes = simd<Real>::lanes;
+        std::size_t i = 0;
+        for (; i + lanes <= x.size(); i += lanes) {
+            simd_store(&y[i], self()(simd_load(&x[i])));
+        }
+        for (; i < x.size(); i++) {
+            y[i] = self()(x[i]);
+        }
+    }
+};
+
+template <typename T>
+concept ExpressionType = std::is_base_of_v<Expression<T>, T>;
+
+template <typename T>
+concept ScalarType = std::is_arithmetic_v<T>;
+
+namespace expression_detail {
+
+// v as a T, where T is a scalar or a GCC vector (whose lanes all get v)
+template <typename T>
+constexpr T broadcast(double v) {
+    if constexpr (std::is_arithmetic_v<T>) {
+        return static_cast<T>(v);
+    } else {
+        T zero = {};
+        using Lane = std::remove_cvref_t<decltype(zero[0])>;
+        return zero + static_cast<Lane>(v);
+    }
+}
+
+template <typename T, typename Fn>
+T lanewise(T v, Fn fn) {
+    if constexpr (std::is_arithmetic_v<T>) {
+        return fn(v);
+    } else {
+        for (std::size_t k = 0; k < sizeof(T) / sizeof(v[0]); k++) {
+            v[k] = fn(v[k]);
+        }
+        return v;
+    }
+}
+
+}  // namespace expression_detail
+
+// Leaves. Zero and One are distinct types so that derivatives can drop the terms they make trivial.
+
+struct Variable : Expression<Variable> {
+    template <typename T>
+    constexpr T operator()(T x) const {
+        return x;
+    }
+};
+
+struct Constant : Expression<Constant> {
+    double value;
+    constexpr explicit Constant(double v) : value(v) {}
+    template <typename T>
+    constexpr T operator()(T) const {
+        return expression_detail::broadcast<T>(value);
+    }
+};
+
+struct Zero : Expression<Zero> {
+    template <typename T>
+    constexpr T operator()(T) const {
+        return expression_detail::broadcast<T>(0.0);
+    }
+};
+
+struct One : Expression<One> {
+    template <typename T>
+    constexpr T operator()(T) const {
+        return expression_detail::broadcast<T>(1.0);
+    }
+};
+
+template <typename E>
+constexpr bool is_zero = std::is_same_v<E, Zero>;
+template <typename E>
+constexpr bool is_one = std::is_same_v<E, One>;
+
+// Interior nodes.
+
+template <typename L, typename R>
+struct Sum : Expression<Sum<L, R>> {
+    L l;
+    R r;
+    constexpr Sum(L a, R b) : l(a), r(b) {}
+    template <typename T>
+    constexpr T operator()(T x) const {
+        return l(x) + r(x);
+    }
+};
+
+template <typename L, typename R>
+struct Difference : Expression<Difference<L, R>> {
+    L l;
+    R r;
+    constexpr Difference(L a, R b) : l(a), r(b) {}
+    template <typename T>
+    constexpr T operator()(T x) const {
+        return l(x) - r(x);
+    }
+};
+
+template <typename L, typename R>
+struct Product : Expression<Product<L, R>> {
+    L l;
+    R r;
+    constexpr Product(L a, R b) : l(a), r(b) {}
+    template <typename T>
+    constexpr T operator()(T x) const {
+        return l(x) * r(x);
+    }
+};
+
+template <typename L, typename R>
+struct Quotient : Expression<Quotient<L, R>> {
+    L l;
+    R r;
+    constexpr Quotient(L a, R b) : l(a), r(b) {}
+    template <typename T>
+    constexpr T operator()(T x) const {
+        return l(x) / r(x);
+    }
+};
+
+template <typename E>
+struct Negation : Expression<Negation<E>> {
+    E e;
+    constexpr explicit Negation(E a) : e(a) {}
+    template <typename T>
+    constexpr T operator()(T x) const {
+        return -e(x);
+    }
+};
+
+// e^n for a compile-time integer n >= 1, by repeated squaring
+template <typename E, int n>
+struct Power : Expression<Power<E, n>> {
+    static_assert(n >= 1);
+    E e;
+    constexpr explicit Power(E a) : e(a) {}
+    template <typename T>
+    constexpr T operator()(T x) const {
+        T base = e(x);
+        T result = base;
+        for (int k = n - 1; k > 0; k >>= 1) {
+            if (k & 1) {
+                result = result * base;
+            }
+            base = base * base;
+        }
+        return result;
+    }
+};
+
+// exp, log, sin, cos, sqrt of an expression
+enum class Function { exp, log, sin, cos, sqrt };
+
+template <Function fn, typename E>
+struct Apply : Expression<Apply<fn, E>> {
+    E e;
+    constexpr explicit Apply(E a) : e(a) {}
+    template <typename T>
+    T operator()(T x) const {
+        return expression_detail::lanewise(e(x), [](auto v) {
+            if constexpr (fn == Function::exp) {
+                return std::exp(v);
+            } else if constexpr (fn == Function::log) {
+                return std::log(v);
+            } else if constexpr (fn == Function::sin) {
+                return std::sin(v);
+            } else if constexpr (fn == Function::cos) {
+                return std::cos(v);
+            } else {
+                return std::sqrt(v);
+            }
+        });
+    }
+};
+
+// Operators. Scalars become Constants; Zero and One are folded away.
+
+template <typename E>
+constexpr auto as_expression(E e) {
+    if constexpr (ScalarType<E>) {
+        return Constant(static_cast<double>(e));
+    } else {
+        return e;
+    }
+}
+
+template <typename L, typename R>
+concept Operands = (ExpressionType<L> && ExpressionType<R>) || (ExpressionType<L> && ScalarType<R>) ||
+                   (ScalarType<L> && ExpressionType<R>);
+
+template <ExpressionType E>
+constexpr auto operator-(E e) {
+    if constexpr (is_zero<E>) {
+        return Zero{};
+    } else {
+        return Negation<E>(e);
+    }
+}
+
+template <typename A, typename B>
+    requires Operands<A, B>
+constexpr auto operator+(A a, B b) {
+    auto l = as_expression(a);
+    auto r = as_expression(b);
+    using L = decltype(l);
+    using R = decltype(r);
+    if constexpr (is_zero<L>) {
+        return r;
+    } else if constexpr (is_zero<R>) {
+        return l;
+    } else {
+        return Sum<L, R>(l, r);
+    }
+}
+
+template <typename A, typename B>
+    requires Operands<A, B>
+constexpr auto operator-(A a, B b) {
+    auto l = as_expression(a);
+    auto r = as_expression(b);
+    using L = decltype(l);
+    using R = decltype(r);
+    if constexpr (is_zero<R>) {
+        return l;
+    } else if constexpr (is_zero<L>) {
+        return -r;
+    } else {
+        return Difference<L, R>(l, r);
+    }
+}
+
+template <typename A, typename B>
+    requires Operands<A, B>
+constexpr auto operator*(A a, B b) {
+    auto l = as_expression(a);
+    auto r = as_expression(b);
+    using L = decltype(l);
+    using R = decltype(r);
+    if constexpr (is_zero<L> || is_zero<R>) {
+        return Zero{};
+    } else if constexpr (is_one<L>) {
+        return r;
+    } else if constexpr (is_one<R>) {
+        return l;
+    } else {
+        return Product<L, R>(l, r);
+    }
+}
+
+template <typename A, typename B>
+    requires Operands<A, B>
+constexpr auto operator/(A a, B b) {
+    auto l = as_expression(a);
+    auto r = as_expression(b);
+    using L = decltype(l);
+    using R = decltype(r);
+    if constexpr (is_zero<L>) {
+        return Zero{};
+    } else if constexpr (is_one<R>) {
+        return l;
+    } else {
+        return Quotient<L, R>(l, r);
+    }
+}
+
+template <int n, ExpressionType E>
+constexpr auto pow(E e) {
+    if constexpr (n == 0) {
+        return One{};
+    } else if constexpr (n == 1) {
+        return e;
+    } else {
+        return Power<E, n>(e);
+    }
+}
+
+template <ExpressionType E>
+constexpr auto exp(E e) {
+    return Apply<Function::exp, E>(e);
+}
+template <ExpressionType E>
+constexpr auto log(E e) {
+    return Apply<Function::log, E>(e);
+}
+template <ExpressionType E>
+constexpr auto sin(E e) {
+    return Apply<Function::sin, E>(e);
+}
+template <ExpressionType E>
+constexpr auto cos(E e) {
+    return Apply<Function::cos, E>(e);
+}
+template <ExpressionType E>
+constexpr auto sqrt(E e) {
+    return Apply<Function::sqrt, E>(e);
+}
+
+// Symbolic derivative with respect to the Variable.
+
+constexpr Zero derivative(Zero) { return {}; }
+constexpr Zero derivative(One) { return {}; }
+constexpr Zero derivative(Constant) { return {}; }
+constexpr One derivative(Variable) { return {}; }
+
+template <typename L, typename R>
+constexpr auto derivative(Sum<L, R> e) {
+    return derivative(e.l) + derivative(e.r);
+}
+
+template <typename L, typename R>
+constexpr auto derivative(Difference<L, R> e) {
+    return derivative(e.l) - derivative(e.r);
+}
+
+template <typename L, typename R>
+constexpr auto derivative(Product<L, R> e) {
+    return derivative(e.l) * e.r + e.l * derivative(e.r);
+}
+
+template <typename L, typename R>
+constexpr auto derivative(Quotient<L, R> e) {
+    return (derivative(e.l) * e.r - e.l * derivative(e.r)) / pow<2>(e.r);
+}
+
+template <typename E>
+constexpr auto derivative(Negation<E> e) {
+    return -derivative(e.e);
+}
+
+template <typename E, int n>
+constexpr auto derivative(Power<E, n> e) {
+    return Constant(n) * pow<n - 1>(e.e) * derivative(e.e);
+}
+
+template <Function fn, typename E>
+constexpr auto derivative(Apply<fn, E> e) {
+    if constexpr (fn == Function::exp) {
+        return e * derivative(e.e);
+    } else if constexpr (fn == Function::log) {
+        return derivative(e.e) / e.e;
+    } else if constexpr (fn == Function::sin) {
+        return cos(e.e) * derivative(e.e);
+    } else if constexpr (fn == Function::cos) {
+        return -(sin(e.e) * derivative(e.e));
+    } else {
+        return derivative(e.e) / (Constant(2) * e);
+    }
+}
+
+// Root finding with symbolic derivatives (see roots.h).
+
+template <ExpressionType E, typename Real>
+constexpr RootResult<Real> newton(const E& f, Real x0, const RootCriteria<Real>& criteria) {
+    return newton(f, derivative(f), x0, criteria);
+}
+
+template <ExpressionType E, typename Real>
+constexpr RootResult<Real> halley(const E& f, Real x0, const RootCriteria<Real>& criteria) {
+    auto slope = derivative(f);
+    return halley(f, slope, derivative(slope), x0, criteria);
+}
@@ -0,0 +1,380 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#include "batch_quadrature.h"
+#include "batch_roots.h"
+
+// Black-Scholes prices and implied volatilities, one at a time or for whole arrays of options.
+//
+// Everything works in the normalised Black model (Jaeckel, "By Implication", 2006, and "Let's be rational", 2015).
+// With forward F, strike K, x = ln(F/K) and total volatility s = sigma sqrt(T), the undiscounted price divided by
+// sqrt(F K) is
+//
+//   b(x, s) = e^(x/2) Phi(x/s + s/2) - e^(-x/2) Phi(x/s - s/2)   for a call
+//
+// Subtracting the intrinsic value and flipping the sign of x turns every option into an out-of-the-money call
+// (x <= 0), whose normalised price lies in (0, e^(x/2)). The implied volatility is then found in two stages:
+//
+//   guess  - as in "Let's be rational": the tangent to b at its inflection point s_c = sqrt(2|x|) meets 0 and
+//            e^(x/2) at s_l and s_u. Between s_l and s_u, s(beta) is interpolated through the three points; below
+//            s_l and above s_u, b is replaced by maps with the right asymptotes and explicit inverses, using
+//            Acklam's rational inverse normal (where Jaeckel uses rational cubic interpolation throughout)
+//   refine - two third-order Householder steps on ln b (below s_c) or on ln(e^(x/2) - b) (above), which are
+//            nearly linear in s where b itself is flat or exponentially small; from the guess, two steps reach
+//            full double precision
+//
+// b and its complement are both computed without cancellation through the scaled complementary error function
+// erfcx(t) = e^(t^2) erfc(t), and the s-derivatives of b are closed forms, so each step costs one exp, one log and
+// two erfcx. Those kernels (and sqrt) are branch-free polynomials written once for double and for the simd<double>
+// vectors of batch_quadrature.h, so the batch functions run simd lanes of options through the same code, with
+// selects instead of branches; chunks of lanes are spread over threads by the driver of batch_roots.h.
+//
+// Prices outside the no-arbitrage bounds (below intrinsic value, or above the forward or strike) have no implied
+// volatility: the result is NaN. A price at intrinsic value, to within rounding, gives 0.
+
+// Struct-of-arrays option data. An empty discount span means undiscounted (forward) prices.
+struct OptionArrays {
+    std::span<const double> forward, strike, expiry, discount;
+    std::span<const unsigned char> call;  // 1 for calls, 0 for puts
+};
+
+namespace implied_volatility_detail {
+
+constexpr double inverse_sqrt_two = 0.7071067811865476;
+constexpr double inverse_sqrt_two_pi = 0.3989422804014327;
+constexpr double sqrt_three = 1.7320508075688772;
+constexpr double tiny = 1e-300;
+constexpr int householder_steps = 2;
+
+// The unsigned integer type with the bits of V: std::uint64_t for double, a vector of them for simd vectors.
+template <typename V>
+struct bits_of {
+    using type = std::uint64_t;
+};
+
+template <>
+struct bits_of<simd<double>::type> {
+    using type = simd<std::uint64_t>::type;
+};
+
+template <typename V>
+using Bits = typename bits_of<V>::type;
+
+// e^x, 0 below x = -708. x = k ln 2 + r with |r| <= ln(2)/2; k is rounded with the 1.5 * 2^52 trick and becomes the
+// exponent field of 2^k directly. ln 2 is split Cody-Waite style so k ln2_hi is exact.
+template <typename V>
+V exp_kernel(V x) {
+    const V clamped = x < -708.0 ? -708.0 : (x > 709.0 ? 709.0 : x);
+    const V shifted = clamped * 1.4426950408889634 + 0x1.8p52;
+    const V k = shifted - 0x1.8p52;
+    const V r = (clamped - k * 6.93147180369123816490e-01) - k * 1.90821492927058770002e-10;
+    V p = r * (1.0 / 6227020800.0) + 1.0 / 479001600.0;
+    p = p * r + 1.0 / 39916800.0;
+    p = p * r + 1.0 / 3628800.0;
+    p = p * r + 1.0 / 362880.0;
+    p = p * r + 1.0 / 40320.0;
+    p = p * r + 1.0 / 5040.0;
+    p = p * r + 1.0 / 720.0;
+    p = p * r + 1.0 / 120.0;
+    p = p * r + 1.0 / 24.0;
+    p = p * r + 1.0 / 6.0;
+    p = p * r + 0.5;
+    p = p * r + 1.0;
+    p = p * r + 1.0;
+    const V scale = std::bit_cast<V>((std::bit_cast<Bits<V>>(shifted) + 1023) << 52);
+    return x < -708.0 ? 0.0 : p * scale;
+}
+
+// Natural log of a positive normal number, as log_positive in random_streams.h: x = 2^e m with m in
+// [sqrt(1/2), sqrt(2)), and log m = 2 atanh(s) with s = (m - 1)/(m + 1).
+template <typename V>
+V log_kernel(V x) {
+    const Bits<V> bits = std::bit_cast<Bits<V>>(x);
+    V e = std::bit_cast<V>((bits >> 52) | 0x4330000000000000ull) - (0x1p52 + 1023.0);
+    V m = std::bit_cast<V>((bits & 0x000fffffffffffffull) | 0x3ff0000000000000ull);
+    const auto high = m > 1.4142135623730951;
+    m = high ? 0.5 * m : m;
+    e = high ? e + 1.0 : e;
+    const V s = (m - 1.0) / (m + 1.0);
+    const V z = s * s;
+    V p = z * (2.0 / 25) + 2.0 / 23;
+    p = p * z + 2.0 / 21;
+    p = p * z + 2.0 / 19;
+    p = p * z + 2.0 / 17;
+    p = p * z + 2.0 / 15;
+    p = p * z + 2.0 / 13;
+    p = p * z + 2.0 / 11;
+    p = p * z + 2.0 / 9;
+    p = p * z + 2.0 / 7;
+    p = p * z + 2.0 / 5;
+    p = p * z + 2.0 / 3;
+    p = p * z + 2.0;
+    return e * 0.6931471805599453 + (e * 2.3190468138462996e-17 + s * p);
+}
+
+// sqrt of y >= 0: halving the exponent bits is within 6%, and four Heron steps square the error down to rounding.
+template <typename V>
+V sqrt_kernel(V y) {
+    V r = std::bit_cast<V>((std::bit_cast<Bits<V>>(y) >> 1) + 0x1ff8000000000000ull);
+    r = 0.5 * (r + y / r);
+    r = 0.5 * (r + y / r);
+    r = 0.5 * (r + y / r);
+    r = 0.5 * (r + y / r);
+    return y > 0.0 ? r : 0.0;
+}
+
+// erfcx(t) = e^(t^2) erfc(t) for t >= 0, as (1 + 2t) erfcx(t) = sum c_j T_j(y) with y = (t - K)/(t + K), K = 3.75
+// (Shepherd and Laframboise 1981), which maps [0, inf) onto [-1, 1). Summed by Clenshaw's recurrence; relative
+// error below 1e-15.
+template <typename V>
+V erfcx_kernel(V t) {
+    static constexpr double c[26] = {
+        2.35515786913480351e+00,  -4.59005458064647746e-03, -8.42491333665179156e-02, 5.92099399981918904e-02,
+        -2.66586684353057522e-02, 9.07499767070526507e-03,  -2.41316354041760806e-03, 4.90775836525808561e-04,
+        -6.91697330250121000e-05, 4.13902798607272954e-06,  7.74038306619833116e-07,  -2.18864010492509243e-07,
+        1.07649994658257874e-08,  4.52195981118790954e-09,  -7.75440021045005580e-10, -6.31808835099190805e-11,
+        2.86879503939606202e-11,  1.94558618438345441e-13,  -9.65469544815190118e-13, 3.25254214295252198e-14,
+        3.34782295924781111e-14,  -1.86464477755846070e-15, -1.25105523994470854e-15, 7.39177418637252763e-17,
+        5.03148864441684459e-17,  -2.20115628559817515e-18};
+    const V y = (t - 3.75) / (t + 3.75);
+    V b1{}, b2{};
+    for (int j = 25; j >= 1; j--) {
+        const V b0 = 2.0 * y * b1 - b2 + c[j];
+        b2 = b1;
+        b1 = b0;
+    }
+    return (y * b1 - b2 + 0.5 * c[0]) / (1.0 + 2.0 * t);
+}
+
+// Standard normal distribution function, Phi(z) = erfc(-z / sqrt 2) / 2.
+template <typename V>
+V normal_cdf(V z) {
+    const V t = z * inverse_sqrt_two;
+    const V tail = 0.5 * erfcx_kernel(t < 0.0 ? -t : t) * exp_kernel(-t * t);  // Phi(-|z|)
+    return z < 0.0 ? tail : 1.0 - tail;
+}
+
+// Phi^-1(p) for p in (0, 1/2], by Acklam's rational approximations (relative error 1.2e-9): a central one above
+// p = 0.02425 and one in sqrt(-2 ln p) for the tail.
+template <typename V>
+V inverse_normal_lower(V p) {
+    const V q = p - 0.5, r = q * q;
+    const V central = (((((-3.969683028665376e+01 * r + 2.209460984245205e+02) * r - 2.759285104469687e+02) * r +
+                          1.383577518672690e+02) * r - 3.066479806614716e+01) * r + 2.506628277459239e+00) * q /
+                      (((((-5.447609879822406e+01 * r + 1.615858368580409e+02) * r - 1.556989798598866e+02) * r +
+                         6.680131188771972e+01) * r - 1.328068155288572e+01) * r + 1.0);
+    const V u = sqrt_kernel(-2.0 * log_kernel(p > tiny ? p : tiny));
+    const V tail = (((((-7.784894002430293e-03 * u - 3.223964580411365e-01) * u - 2.400758277161838e+00) * u -
+                      2.549732539343734e+00) * u + 4.374664141464968e+00) * u + 2.938163982698783e+00) /
+                   ((((7.784695709041462e-03 * u + 3.224671290700398e-01) * u + 2.445134137142996e+00) * u +
+                     3.754408661907416e+00) * u + 1.0);
+    return p < 0.02425 ? tail : central;
+}
+
+// The normalised out-of-the-money call (x <= 0, s > 0) with bound = e^(x/2): its price b, the complement
+// h = bound - b, and vega = db/ds. With E = e^(-(x^2/s^2 + s^2/4)/2), a = -x/s - s/2 and c = -x/s + s/2 >= 0,
+//   b = E (erfcx(a/sqrt2) - erfcx(c/sqrt2)) / 2       for a >= 0
+//   h = E (erfcx(-a/sqrt2) + erfcx(c/sqrt2)) / 2      for a < 0
+// so whichever of b and h is small is never a difference of nearly equal numbers.
+template <typename V>
+void normalised_call(V x, V s, V bound, V& b, V& h, V& vega) {
+    const V q = x / s;
+    const V e = exp_kernel(-0.5 * (q * q + 0.25 * s * s));
+    const V a = -q - 0.5 * s, c = -q + 0.5 * s;
+    const V ea = erfcx_kernel((a < 0.0 ? -a : a) * inverse_sqrt_two);
+    const V ec = erfcx_kernel(c * inverse_sqrt_two);
+    const V small = 0.5 * e * (a < 0.0 ? ea + ec : ea - ec);
+    b = a < 0.0 ? bound - small : small;
+    h = a < 0.0 ? small : bound - small;
+    vega = e * inverse_sqrt_two_pi;
+}
+
+// Total volatility s of the normalised out-of-the-money call with price beta, 0 < beta < bound = e^(x/2).
+template <typename V>
+V normalised_volatility(V x, V beta, V bound) {
+    const V ax = -x;
+    // the inflection point s_c = sqrt(2|x|), where a = 0, so b_c = e^(x/2) (1 - erfcx(sqrt|x|)) / 2 and
+    // vega_c = e^(-|x|/2) / sqrt(2 pi); and the points s_l, s_u where the tangent there reaches 0 and e^(x/2)
+    const V s_c = sqrt_kernel(2.0 * ax);
+    const V b_c = 0.5 * bound * (1.0 - erfcx_kernel(sqrt_kernel(ax)));
+    const V vega_c = bound * inverse_sqrt_two_pi;
+    const V s_l = s_c - b_c / vega_c > 1e-8 ? s_c - b_c / vega_c : 1e-8;
+    const V s_u = s_c + (bound - b_c) / vega_c;
+    V b_l, h_l, vega_l, b_u, h_u, vega_u;
+    normalised_call(x, s_l, bound, b_l, h_l, vega_l);
+    normalised_call(x, s_u, bound, b_u, h_u, vega_u);
+    const auto lower = beta < b_c;
+
+    // between s_l and s_u: cubic Hermite interpolation of s(beta) through the three points, with slopes 1/vega
+    const V b0 = lower ? b_l : b_c, b1 = lower ? b_c : b_u;
+    const V s0 = lower ? s_l : s_c, s1 = lower ? s_c : s_u;
+    const V width = b1 - b0;
+    const V d0 = width / (lower ? vega_l : vega_c), d1 = width / (lower ? vega_c : vega_u);
+    const V t = (beta - b0) / width, t2 = t * t, t3 = t2 * t;
+    const V s_middle = (2.0 * t3 - 3.0 * t2 + 1.0) * s0 + (t3 - 2.0 * t2 + t) * d0 + (3.0 * t2 - 2.0 * t3) * s1 +
+                       (t3 - t2) * d1;
+
+    // below s_l: f_l(s) = 2 pi |x| / (3 sqrt 3) Phi(-|x| / (sqrt(3) s))^3 has the same small-s asymptote as b and an
+    // explicit inverse. Above s_u: e^(x/2) - b ~ (e^(x/2) + e^(-x/2)) Phi(-s/2). Each map is scaled to agree with b
+    // at its end of the middle region, the scale fading out towards beta = 0 and beta = e^(x/2) respectively.
+    const V complement = bound - beta;
+    const V lower_scale = 3.0 * sqrt_three / (2.0 * 3.141592653589793 * (ax > tiny ? ax : tiny));
+    const V phi_l = normal_cdf(-ax / (sqrt_three * s_l));
+    const V fit_l = phi_l * phi_l * phi_l / (lower_scale * (b_l > tiny ? b_l : tiny));
+    const V fit_u = normal_cdf(-0.5 * s_u) * (bound + 1.0 / bound) / (h_u > tiny ? h_u : tiny);
+    const V log_beta = log_kernel(beta);
+    const V p_lower = exp_kernel((log_beta + log_kernel(lower_scale) +
+                                  beta / (b_l > tiny ? b_l : tiny) * log_kernel(fit_l)) / 3.0);
+    const V p_upper = complement / (bound + 1.0 / bound) * exp_kernel(complement / h_u * log_kernel(fit_u));
+    const auto tail_low = beta < b_l;
+    const auto tail = tail_low | (beta > b_u);
+    V p = tail_low ? p_lower : p_upper;
+    p = p < 0.5 ? (p > tiny ? p : tiny) : 0.5;
+    const V z = -inverse_normal_lower(p);  // >= 0
+    const V s_tail = tail_low ? ax / (sqrt_three * (z > tiny ? z : tiny)) : 2.0 * z;
+    V s = tail ? s_tail : s_middle;
+    s = s > 1e-8 ? s : 1e-8;
+
+    // Householder steps on g = ln v - ln target, v = b (lower) or h (upper); with r_k = v^(k) / v,
+    // g' = r1, g'' = r2 - r1^2, g''' = r3 - 3 r1 r2 + 2 r1^3
+    const V log_target = lower ? log_beta : log_kernel(complement);
+    const V sign = lower ? 1.0 : -1.0;
+    for (int step = 0; step < householder_steps; step++) {
+        V b, h, vega;
+        normalised_call(x, s, bound, b, h, vega);
+        V v = lower ? b : h;
+        v = v > tiny ? v : tiny;
+        const V w = x * x / (s * s * s) - 0.25 * s;  // b'' / b'
+        const V r1 = sign * vega / v;
+        const V r2 = r1 * w;
+        const V r3 = r1 * (w * w - 3.0 * x * x / (s * s * s * s) - 0.25);
+        const V g2 = r2 - r1 * r1;
+        const V g3 = r3 - 3.0 * r1 * r2 + 2.0 * r1 * r1 * r1;
+        const V newton = (log_target - log_kernel(v)) / r1;
+        const V gamma = g2 / r1, delta = g3 / r1;
+        const V next = s + newton * (1.0 + 0.5 * gamma * newton) / (1.0 + newton * (gamma + delta * newton / 6.0));
+        // a wild step from a poor guess is limited to a factor of 8 either way, which keeps s positive
+        s = next > 0.125 * s ? (next < 8.0 * s ? next : 8.0 * s) : 0.125 * s;
+    }
+    return s;
+}
+
+// Reduces an option to its normalised out-of-the-money call and returns the total volatility, NaN outside the
+// no-arbitrage bounds. call is a bool, or a lane mask for vectors.
+//
+// The intrinsic value is subtracted in price space, where a price quoted at exactly F - K (or K - F) leaves a time
+// value of zero or a few ulps of the price; anything within that rounding (8 ulps) counts as intrinsic and gives 0.
+template <typename V, typename Mask>
+V implied_total_volatility(V price, V forward, V strike, Mask call) {
+    const V x = log_kernel(forward / strike);
+    const V ax = x < 0.0 ? -x : x;
+    const V bound = exp_kernel(-0.5 * ax);  // e^(x/2) of the reduced call
+    const V half_moneyness = x < 0.0 ? bound : 1.0 / bound;  // e^(x/2) of the option itself
+    const V payoff = call ? forward - strike : strike - forward;
+    const V time_value = price - (payoff > 0.0 ? payoff : 0.0);
+    const V rounding = 8.0 * std::numeric_limits<double>::epsilon() * price;
+    const auto intrinsic = (time_value <= rounding) & (time_value >= -rounding);
+    const V beta = time_value / (strike * half_moneyness);
+    const auto valid = (time_value > rounding) & (beta < bound);
+    const V s = normalised_volatility(-ax, valid ? beta : 0.5 * bound, bound);
+    return valid ? s : (intrinsic ? 0.0 : std::numeric_limits<double>::quiet_NaN());
+}
+
+// Undiscounted price of the option at total volatility s > 0, as an out-of-the-money call plus intrinsic value.
+template <typename V, typename Mask>
+V undiscounted_price(V forward, V strike, V s, Mask call) {
+    const V x = log_kernel(forward / strike);
+    const V ax = x < 0.0 ? -x : x;
+    const V bound = exp_kernel(-0.5 * ax);
+    const V inverse_bound = 1.0 / bound;
+    const auto in_the_money = call ? x > 0.0 : x < 0.0;
+    V b, h, vega;
+    normalised_call(-ax, s, bound, b, h, vega);
+    return strike * (x < 0.0 ? bound : inverse_bound) * (b + (in_the_money ? inverse_bound - bound : 0.0));
+}
+
+// Lanes [first, first + lanes) of an option array, padded past its end; an empty array reads as `fallback`.
+inline simd<double>::type load_lanes(std::span<const double> values, std::size_t first, double fallback = 1.0) {
+    return values.empty() ? simd<double>::type{} + fallback : batch_roots_detail::load_padded(values, first);
+}
+
+// The call flags of the same lanes, as a lane mask.
+inline auto load_call_mask(std::span<const unsigned char> call, std::size_t first) {
+    simd<double>::type flags{};
+    for (std::size_t k = 0; k < simd<double>::lanes; k++) {
+        flags[k] = call[std::min(first + k, call.size() - 1)];
+    }
+    return flags != 0.0;
+}
+
+}  // namespace implied_volatility_detail
+
+// Black price of a European option on a forward, times the discount factor.
+inline double black_price(double forward, double strike, double volatility, double expiry, bool call,
+                          double discount = 1.0) {
+    using namespace implied_volatility_detail;
+    const double s = volatility * sqrt_kernel(expiry);
+    if (!(s > 0.0)) {
+        const double intrinsic = call ? forward - strike : strike - forward;
+        return discount * (intrinsic > 0.0 ? intrinsic : 0.0);
+    }
+    return discount * undiscounted_price(forward, strike, s, call);
+}
+
+// Black-Scholes price on a spot with continuous rate and dividend yield.
+inline double black_scholes_price(double spot, double strike, double volatility, double expiry, double rate,
+                                  double dividend, bool call) {
+    using implied_volatility_detail::exp_kernel;
+    return black_price(spot * exp_kernel((rate - dividend) * expiry), strike, volatility, expiry, call,
+                       exp_kernel(-rate * expiry));
+}
+
+// Implied Black volatility of a (discounted) option price; NaN outside the no-arbitrage bounds.
+inline double implied_volatility(double price, double forward, double strike, double expiry, bool call,
+                                 double discount = 1.0) {
+    using namespace implied_volatility_detail;
+    return implied_total_volatility(price / discount, forward, strike, call) / sqrt_kernel(expiry);
+}
+
+// Prices every option of the arrays at the volatilities given (which must be positive).
+inline void black_price_batch(const OptionArrays& options, std::span<const double> volatility,
+                              std::span<double> prices, const BatchRootOptions& parallel = {}) {
+    using namespace implied_volatility_detail;
+    using Vec = simd<double>::type;
+    batch_roots_detail::run_groups<double>(prices.size(), parallel, [&](std::size_t first) {
+        const Vec s = load_lanes(volatility, first) * sqrt_kernel(load_lanes(options.expiry, first));
+        const Vec price = load_lanes(options.discount, first) *
+                          undiscounted_price(load_lanes(options.forward, first), load_lanes(options.strike, first),
+                                             s, load_call_mask(options.call, first));
+        for (std::size_t k = 0; k < simd<double>::lanes && first + k < prices.size(); k++) {
+            prices[first + k] = price[k];
+        }
+        return std::size_t(0);
+    });
+}
+
+// Implied volatility of every price; returns how many options had one (the rest are NaN).
+inline std::size_t implied_volatility_batch(const OptionArrays& options, std::span<const double> prices,
+                                            std::span<double> volatility, const BatchRootOptions& parallel = {}) {
+    using namespace implied_volatility_detail;
+    using Vec = simd<double>::type;
+    return batch_roots_detail::run_groups<double>(volatility.size(), parallel, [&](std::size_t first) {
+        const Vec undiscounted = load_lanes(prices, first) / load_lanes(options.discount, first);
+        const Vec total = implied_total_volatility(undiscounted, load_lanes(options.forward, first),
+                                                   load_lanes(options.strike, first),
+                                                   load_call_mask(options.call, first));
+        const Vec sigma = total / sqrt_kernel(load_lanes(options.expiry, first));
+        std::size_t solved = 0;
+        for (std::size_t k = 0; k < simd<double>::lanes && first + k < volatility.size(); k++) {
+            volatility[first + k] = sigma[k];
+            solved += sigma[k] == sigma[k] ? 1 : 0;
+        }
+        return solved;
+    });
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+// Interpolation of tabulated points. lerp and interpolate_linear are constexpr; CubicSpline builds its coefficients
+// at run time and is explicitly instantiated for float and double (see riemann_integral.h).
+
+template <typename Real>
+constexpr Real lerp(Real a, Real b, Real t) {
+    return a + t * (b - a);
+}
+
+// Index i of the interval [xs[i], xs[i + 1]] containing x, for sorted xs with at least two points. Points outside
+// the table use the first or last interval.
+template <typename Real>
+constexpr std::size_t find_interval(std::span<const Real> xs, Real x) {
+    std::size_t lo = 0, hi = xs.size() - 1;
+    while (hi - lo > 1) {
+        std::size_t mid = lo + (hi - lo) / 2;
+        if (x < xs[mid]) {
+            hi = mid;
+        } else {
+            lo = mid;
+        }
+    }
+    return lo;
+}
+
+// Piecewise-linear interpolation through (xs[i], ys[i]); extrapolates linearly beyond the ends. NaN for an empty
+// table or when xs and ys differ in length.
+template <typename Real>
+constexpr Real interpolate_linear(std::span<const Real> xs, std::span<const Real> ys, Real x) {
+    if (xs.empty() || xs.size() != ys.size()) {
+        return std::numeric_limits<Real>::quiet_NaN();
+    }
+    if (xs.size() == 1) {
+        return ys[0];
+    }
+    std::size_t i = find_interval(xs, x);
+    return lerp(ys[i], ys[i + 1], (x - xs[i]) / (xs[i + 1] - xs[i]));
+}
+
+// Natural cubic spline: twice continuously differentiable, with zero second derivative at both ends.
+template <typename Real>
+class CubicSpline {
+public:
+    CubicSpline(std::vector<Real> xs, std::vector<Real> ys);
+
+    Real operator()(Real x) const;
+    Real derivative(Real x) const;
+    // Exact integral of the spline over the whole table.
+    Real integral() const;
+
+private:
+    std::vector<Real> x, y;
+    std::vector<Real> second;  // second derivative at each knot
+};
+
+template <typename Real>
+CubicSpline<Real>::CubicSpline(std::vector<Real> xs, std::vector<Real> ys)
+    : x(std::move(xs)), y(std::move(ys)), second(x.size(), Real(0)) {
+    const std::size_t n = x.size();
+    if (n < 3) {
+        return;  // a straight line; second derivatives stay zero
+    }
+    // tridiagonal system for the interior second derivatives, solved by the Thomas algorithm
+    std::vector<Real> diagonal(n, Real(0)), rhs(n, Real(0));
+    for (std::size_t i = 1; i + 1 < n; i++) {
+        Real h0 = x[i] - x[i - 1], h1 = x[i + 1] - x[i];
+        diagonal[i] = 2 * (h0 + h1);
+        rhs[i] = 6 * ((y[i + 1] - y[i]) / h1 - (y[i] - y[i - 1]) / h0);
+    }
+    for (std::size_t i = 2; i + 1 < n; i++) {
+        Real h0 = x[i] - x[i - 1];
+        Real factor = h0 / diagonal[i - 1];
+        diagonal[i] -= factor * h0;
+        rhs[i] -= factor * rhs[i - 1];
+    }
+    for (std::size_t i = n - 2; i >= 1; i--) {
+        Real upper = (i + 2 < n) ? (x[i + 1] - x[i]) * second[i + 1] : Real(0);
+        second[i] = (rhs[i] - upper) / diagonal[i];
+    }
+}
+
+template <typename Real>
+Real CubicSpline<Real>::operator()(Real at) const {
+    if (x.size() < 2) {
+        return y.empty() ? Real(0) : y[0];
+    }
+    std::size_t i = find_interval(std::span<const Real>(x), at);
+    Real h = x[i + 1] - x[i];
+    Real a = (x[i + 1] - at) / h, b = (at - x[i]) / h;
+    return a * y[i] + b * y[i + 1] + ((a * a * a - a) * second[i] + (b * b * b - b) * second[i + 1]) * h * h / 6;
+}
+
+template <typename Real>
+Real CubicSpline<Real>::derivative(Real at) const {
+    if (x.size() < 2) {
+        return Real(0);
+    }
+    std::size_t i = find_interval(std::span<const Real>(x), at);
+    Real h = x[i + 1] - x[i];
+    Real a = (x[i + 1] - at) / h, b = (at - x[i]) / h;
+    return (y[i + 1] - y[i]) / h + ((1 - 3 * a * a) * second[i] + (3 * b * b - 1) * second[i + 1]) * h / 6;
+}
+
+template <typename Real>
+Real CubicSpline<Real>::integral() const {
+    Real sum = 0;
+    for (std::size_t i = 0; i + 1 < x.size(); i++) {
+        Real h = x[i + 1] - x[i];
+        sum += h * (y[i] + y[i + 1]) / 2 - h * h * h * (second[i] + second[i + 1]) / 24;
+    }
+    return sum;
+}
@@ -0,0 +1,482 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+// Solving systems F(x) = 0 of n equations in n unknowns, the multidimensional counterpart of roots.h.
+//
+// A system is a callable f(x, out) writing F(x) into out, both spans of length n. A Jacobian, where given, is a
+// callable jacobian(x, J) filling the row-major n x n matrix J[i * n + j] = dF_i/dx_j.
+//
+//   newton        - Newton's method with a dense LU solve per step. Without a Jacobian it is estimated by forward
+//                   differences, at n evaluations of F per step
+//   broyden       - Broyden's ("good") quasi-Newton method: the Jacobian is factored once and then updated from the
+//                   steps taken, in the compact form of Kelley (1995) that stores only the steps. The history restarts
+//                   from a fresh Jacobian after `broyden_memory` steps or whenever a full step fails to reduce |F|
+//   newton_krylov - Jacobian-free Newton-Krylov: each Newton system J d = -F is solved inexactly by restarted
+//                   GMRES, with J v approximated by a difference of F along v, so no matrix is ever formed. The
+//                   linear tolerance follows Eisenstat and Walker's second choice, loose far from the root and tight
+//                   near it
+//
+// Every Newton step is damped by a backtracking line search that halves it until |F| falls by the Armijo fraction.
+// A solve stops when |F(x)|_2 <= criteria.f_tolerance or the step is within criteria.x_tolerance (relative to
+// 1 + |x|), and fails after criteria.max_iterations steps or on a singular Jacobian.
+//
+// NonlinearSolver owns every work vector, sized for n when it is constructed, so repeated solves of systems of the
+// same size (a calibration loop, or the implicit stage of every time step) allocate nothing. The n x n matrix used by
+// newton and broyden is allocated by the first call that needs it and kept.
+
+template <typename Real>
+struct SystemCriteria {
+    Real f_tolerance = Real(1e-10);
+    Real x_tolerance = 0;
+    int max_iterations = 50;
+};
+
+template <typename Real>
+struct SystemResult {
+    Real residual = 0;  // |F(x)|_2 at the returned x
+    int iterations = 0;
+    int evaluations = 0;         // calls of f, including those for difference Jacobians and products
+    int linear_iterations = 0;   // GMRES iterations (newton_krylov only)
+    bool converged = false;
+};
+
+struct NonlinearSolverOptions {
+    int krylov_dimension = 30;  // GMRES restart length
+    int krylov_restarts = 10;
+    int broyden_memory = 20;    // steps kept before the Jacobian is refreshed
+    int line_search_steps = 20;
+};
+
+namespace nonlinear_detail {
+
+template <typename Real>
+Real dot(std::span<const Real> a, std::span<const Real> b) {
+    Real sum = 0;
+    for (std::size_t i = 0; i < a.size(); i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+template <typename Real>
+Real norm(std::span<const Real> a) {
+    return std::sqrt(dot(a, a));
+}
+
+// y += alpha x
+template <typename Real>
+void axpy(Real alpha, std::span<const Real> x, std::span<Real> y) {
+    for (std::size_t i = 0; i < y.size(); i++) {
+        y[i] += alpha * x[i];
+    }
+}
+
+// In-place LU factorisation with partial pivoting of the row-major n x n matrix a. Returns false if it is singular.
+template <typename Real>
+bool lu_factor(std::span<Real> a, std::size_t n, std::span<std::size_t> pivots) {
+    for (std::size_t k = 0; k < n; k++) {
+        std::size_t p = k;
+        for (std::size_t i = k + 1; i < n; i++) {
+            if (std::abs(a[i * n + k]) > std::abs(a[p * n + k])) {
+                p = i;
+            }
+        }
+        pivots[k] = p;
+        if (a[p * n + k] == 0) {
+            return false;
+        }
+        if (p != k) {
+            std::swap_ranges(&a[k * n], &a[k * n] + n, &a[p * n]);
+        }
+        const Real inverse = 1 / a[k * n + k];
+        for (std::size_t i = k + 1; i < n; i++) {
+            const Real l = a[i * n + k] * inverse;
+            a[i * n + k] = l;
+            if (l != 0) {
+                Real* row = &a[i * n];
+                const Real* pivot_row = &a[k * n];
+                for (std::size_t j = k + 1; j < n; j++) {
+                    row[j] -= l * pivot_row[j];
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// Solves LU x = b in place, with the factors and pivots from lu_factor.
+template <typename Real>
+void lu_solve(std::span<const Real> a, std::size_t n, std::span<const std::size_t> pivots, std::span<Real> b) {
+    for (std::size_t k = 0; k < n; k++) {
+        std::swap(b[k], b[pivots[k]]);
+        for (std::size_t i = k + 1; i < n; i++) {
+            b[i] -= a[i * n + k] * b[k];
+        }
+    }
+    for (std::size_t k = n; k-- > 0;) {
+        Real sum = b[k];
+        for (std::size_t j = k + 1; j < n; j++) {
+            sum -= a[k * n + j] * b[j];
+        }
+        b[k] = sum / a[k * n + k];
+    }
+}
+
+}  // namespace nonlinear_detail
+
+template <typename Real>
+class NonlinearSolver {
+public:
+    explicit NonlinearSolver(std::size_t unknowns, const NonlinearSolverOptions& solver_options = {})
+        : n(unknowns), options(solver_options), residual(n), trial(n), trial_residual(n), step(n), scratch(n),
+          scratch_residual(n), pivots(n), basis((options.krylov_dimension + 1) * n),
+          hessenberg((options.krylov_dimension + 1) * options.krylov_dimension), cosines(options.krylov_dimension),
+          sines(options.krylov_dimension), projected(options.krylov_dimension + 1),
+          steps((options.broyden_memory + 1) * n), step_norms(options.broyden_memory + 1) {}
+
+    std::size_t size() const { return n; }
+
+    template <typename F, typename J>
+    SystemResult<Real> newton(F&& f, J&& jacobian, std::span<Real> x, const SystemCriteria<Real>& criteria) {
+        return dense_newton(f, [&](std::span<const Real> at, SystemResult<Real>&) { jacobian(at, matrix_view()); }, x,
+                            criteria);
+    }
+
+    template <typename F>
+    SystemResult<Real> newton(F&& f, std::span<Real> x, const SystemCriteria<Real>& criteria) {
+        return dense_newton(f, [&](std::span<const Real> at, SystemResult<Real>& result) {
+            difference_jacobian(f, at, result);
+        }, x, criteria);
+    }
+
+    template <typename F, typename J>
+    SystemResult<Real> broyden(F&& f, J&& jacobian, std::span<Real> x, const SystemCriteria<Real>& criteria) {
+        return broyden_method(f, [&](std::span<const Real> at, SystemResult<Real>&) { jacobian(at, matrix_view()); },
+                              x, criteria);
+    }
+
+    template <typename F>
+    SystemResult<Real> broyden(F&& f, std::span<Real> x, const SystemCriteria<Real>& criteria) {
+        return broyden_method(f, [&](std::span<const Real> at, SystemResult<Real>& result) {
+            difference_jacobian(f, at, result);
+        }, x, criteria);
+    }
+
+    template <typename F>
+    SystemResult<Real> newton_krylov(F&& f, std::span<Real> x, const SystemCriteria<Real>& criteria) {
+        using namespace nonlinear_detail;
+        SystemResult<Real> result;
+        f(std::span<const Real>(x), std::span<Real>(residual));
+        result.evaluations++;
+        result.residual = norm<Real>(residual);
+        Real previous = result.residual;
+        Real eta = Real(0.5);
+        for (result.iterations = 1; result.iterations <= criteria.max_iterations; result.iterations++) {
+            if (result.residual <= criteria.f_tolerance) {
+                result.converged = true;
+                return result;
+            }
+            if (result.iterations > 1) {
+                // Eisenstat-Walker choice 2, kept from falling too fast while the previous eta was still large
+                const Real ratio = result.residual / previous;
+                const Real next = Real(0.9) * ratio * ratio;
+                const Real floor = Real(0.9) * eta * eta;
+                eta = std::min(Real(0.9), floor > Real(0.1) ? std::max(next, floor) : next);
+                eta = std::max(eta, Real(0.5) * criteria.f_tolerance / result.residual);
+            }
+            gmres(f, x, eta * result.residual, result);
+            previous = result.residual;
+            if (!line_search(f, x, result)) {
+                return result;
+            }
+            if (converged_step(x, criteria)) {
+                result.converged = true;
+                return result;
+            }
+        }
+        result.iterations = criteria.max_iterations;
+        result.converged = result.residual <= criteria.f_tolerance;
+        return result;
+    }
+
+private:
+    std::size_t n;
+    NonlinearSolverOptions options;
+    std::vector<Real> residual, trial, trial_residual, step, scratch, scratch_residual;
+    std::vector<Real> matrix;  // n x n, allocated on first use
+    std::vector<std::size_t> pivots;
+    // GMRES: Krylov basis (one vector per row), Hessenberg matrix, Givens rotations and the rotated right-hand side
+    std::vector<Real> basis, hessenberg, cosines, sines, projected;
+    // Broyden: the steps s_0 .. s_m and their squared norms
+    std::vector<Real> steps, step_norms;
+
+    std::span<Real> matrix_view() {
+        matrix.resize(n * n);
+        return matrix;
+    }
+
+    std::span<Real> basis_vector(std::size_t k) { return std::span<Real>(basis).subspan(k * n, n); }
+    std::span<Real> broyden_step(std::size_t k) { return std::span<Real>(steps).subspan(k * n, n); }
+
+    // Forward-difference Jacobian at x, whose residual is in `residual`.
+    template <typename F>
+    void difference_jacobian(F&& f, std::span<const Real> x, SystemResult<Real>& result) {
+        std::span<Real> a = matrix_view();
+        std::copy(x.begin(), x.end(), scratch.begin());
+        const Real root_epsilon = std::sqrt(std::numeric_limits<Real>::epsilon());
+        for (std::size_t j = 0; j < n; j++) {
+            const Real h = root_epsilon * std::max(std::abs(x[j]), Real(1));
+            scratch[j] = x[j] + h;
+            const Real actual = scratch[j] - x[j];  // the representable increment
+            f(std::span<const Real>(scratch), std::span<Real>(scratch_residual));
+            result.evaluations++;
+            for (std::size_t i = 0; i < n; i++) {
+                a[i * n + j] = (scratch_residual[i] - residual[i]) / actual;
+            }
+            scratch[j] = x[j];
+        }
+    }
+
+    // J v by a difference of F along v, into out; x's residual is in `residual`.
+    template <typename F>
+    void jacobian_product(F&& f, std::span<const Real> x, std::span<const Real> v, std::span<Real> out,
+                          SystemResult<Real>& result) {
+        using namespace nonlinear_detail;
+        const Real v_norm = norm(v);
+        if (v_norm == 0) {
+            std::fill(out.begin(), out.end(), Real(0));
+            return;
+        }
+        const Real h = std::sqrt(std::numeric_limits<Real>::epsilon()) * (1 + norm(x)) / v_norm;
+        for (std::size_t i = 0; i < n; i++) {
+            scratch[i] = x[i] + h * v[i];
+        }
+        f(std::span<const Real>(scratch), out);
+        result.evaluations++;
+        for (std::size_t i = 0; i < n; i++) {
+            out[i] = (out[i] - residual[i]) / h;
+        }
+    }
+
+    // Tries x + lambda step for lambda = 1, 1/2, 1/4, ... until |F| falls by the Armijo fraction, then moves x there
+    // (and step becomes the step actually taken). Returns false if no trial is accepted; x is then unchanged.
+    template <typename F>
+    bool line_search(F&& f, std::span<Real> x, SystemResult<Real>& result, Real* accepted_lambda = nullptr) {
+        using namespace nonlinear_detail;
+        constexpr Real armijo = Real(1e-4);
+        Real lambda = 1;
+        for (int k = 0; k < options.line_search_steps; k++, lambda /= 2) {
+            for (std::size_t i = 0; i < n; i++) {
+                trial[i] = x[i] + lambda * step[i];
+            }
+            f(std::span<const Real>(trial), std::span<Real>(trial_residual));
+            result.evaluations++;
+            const Real trial_norm = norm<Real>(trial_residual);
+            if (trial_norm <= (1 - armijo * lambda) * result.residual) {
+                for (std::size_t i = 0; i < n; i++) {
+                    step[i] = trial[i] - x[i];
+                }
+                std::copy(trial.begin(), trial.end(), x.begin());
+                residual.swap(trial_residual);
+                result.residual = trial_norm;
+                if (accepted_lambda) {
+                    *accepted_lambda = lambda;
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool converged_step(std::span<const Real> x, const SystemCriteria<Real>& criteria) const {
+        using namespace nonlinear_detail;
+        return criteria.x_tolerance > 0 && norm<Real>(step) <= criteria.x_tolerance * (1 + norm(x));
+    }
+
+    // Factors the Jacobian at x into matrix and pivots; returns false if it is singular.
+    template <typename Jacobian>
+    bool factor_jacobian(Jacobian&& jacobian, std::span<const Real> x, SystemResult<Real>& result) {
+        jacobian(x, result);
+        return nonlinear_detail::lu_factor<Real>(matrix, n, pivots);
+    }
+
+    template <typename F, typename Jacobian>
+    SystemResult<Real> dense_newton(F&& f, Jacobian&& jacobian, std::span<Real> x,
+                                    const SystemCriteria<Real>& criteria) {
+        using namespace nonlinear_detail;
+        SystemResult<Real> result;
+        f(std::span<const Real>(x), std::span<Real>(residual));
+        result.evaluations++;
+        result.residual = norm<Real>(residual);
+        for (result.iterations = 1; result.iterations <= criteria.max_iterations; result.iterations++) {
+            if (result.residual <= criteria.f_tolerance) {
+                result.converged = true;
+                return result;
+            }
+            if (!factor_jacobian(jacobian, x, result)) {
+                return result;
+            }
+            for (std::size_t i = 0; i < n; i++) {
+                step[i] = -residual[i];
+            }
+            lu_solve<Real>(matrix, n, pivots, step);
+            if (!line_search(f, x, result)) {
+                return result;
+            }
+            if (converged_step(x, criteria)) {
+                result.converged = true;
+                return result;
+            }
+        }
+        result.iterations = criteria.max_iterations;
+        result.converged = result.residual <= criteria.f_tolerance;
+        return result;
+    }
+
+    // Kelley's compact Broyden: with H_0 = J_0^-1 and full steps s_k, H_{k+1} = (I + s_{k+1} s_k^T / |s_k|^2) H_k,
+    // so the next step is z / (1 - s_k.z / |s_k|^2) with z = -H_0 F(x) passed through the earlier updates.
+    template <typename F, typename Jacobian>
+    SystemResult<Real> broyden_method(F&& f, Jacobian&& jacobian, std::span<Real> x,
+                                      const SystemCriteria<Real>& criteria) {
+        using namespace nonlinear_detail;
+        SystemResult<Real> result;
+        f(std::span<const Real>(x), std::span<Real>(residual));
+        result.evaluations++;
+        result.residual = norm<Real>(residual);
+        std::size_t history = 0;  // steps stored since the last Jacobian
+        for (result.iterations = 1; result.iterations <= criteria.max_iterations; result.iterations++) {
+            if (result.residual <= criteria.f_tolerance) {
+                result.converged = true;
+                return result;
+            }
+            if (history == 0 && !factor_jacobian(jacobian, x, result)) {
+                return result;
+            }
+            // z = -H F(x)
+            for (std::size_t i = 0; i < n; i++) {
+                step[i] = -residual[i];
+            }
+            lu_solve<Real>(matrix, n, pivots, step);
+            for (std::size_t j = 0; j + 1 < history; j++) {
+                axpy<Real>(dot<Real>(broyden_step(j), step) / step_norms[j], broyden_step(j + 1), step);
+            }
+            if (history > 0) {
+                const std::size_t last = history - 1;
+                const Real scale = 1 - dot<Real>(broyden_step(last), step) / step_norms[last];
+                if (scale == 0) {
+                    history = 0;  // the update is singular; start again from a fresh Jacobian
+                    continue;
+                }
+                for (Real& s : step) {
+                    s /= scale;
+                }
+            }
+            Real lambda = 0;
+            if (!line_search(f, x, result, &lambda)) {
+                if (history == 0) {
+                    return result;  // not even the true Jacobian's step helps
+                }
+                history = 0;
+                continue;
+            }
+            if (converged_step(x, criteria)) {
+                result.converged = true;
+                return result;
+            }
+            if (lambda < 1 || history == static_cast<std::size_t>(options.broyden_memory)) {
+                history = 0;  // the compact update assumes full steps; refresh the Jacobian
+                continue;
+            }
+            std::copy(step.begin(), step.end(), broyden_step(history).begin());
+            step_norms[history] = dot<Real>(step, step);
+            history++;
+        }
+        result.iterations = criteria.max_iterations;
+        result.converged = result.residual <= criteria.f_tolerance;
+        return result;
+    }
+
+    // Restarted GMRES for J d = -F(x), into step, stopping when the linear residual is within tolerance.
+    template <typename F>
+    void gmres(F&& f, std::span<const Real> x, Real tolerance, SystemResult<Real>& result) {
+        using namespace nonlinear_detail;
+        const std::size_t m = static_cast<std::size_t>(options.krylov_dimension);
+        auto h = [&](std::size_t i, std::size_t j) -> Real& { return hessenberg[i * m + j]; };
+        std::fill(step.begin(), step.end(), Real(0));
+        for (int restart = 0; restart <= options.krylov_restarts; restart++) {
+            // r0 = -F - J d, into the first basis vector
+            std::span<Real> v0 = basis_vector(0);
+            if (restart == 0) {
+                for (std::size_t i = 0; i < n; i++) {
+                    v0[i] = -residual[i];
+                }
+            } else {
+                jacobian_product(f, x, step, v0, result);
+                for (std::size_t i = 0; i < n; i++) {
+                    v0[i] = -residual[i] - v0[i];
+                }
+            }
+            const Real beta = norm<Real>(v0);
+            if (beta <= tolerance) {
+                return;
+            }
+            for (Real& v : v0) {
+                v /= beta;
+            }
+            std::fill(projected.begin(), projected.end(), Real(0));
+            projected[0] = beta;
+            std::size_t k = 0;
+            while (k < m) {
+                // Arnoldi with modified Gram-Schmidt
+                std::span<Real> w = basis_vector(k + 1);
+                jacobian_product(f, x, basis_vector(k), w, result);
+                result.linear_iterations++;
+                for (std::size_t i = 0; i <= k; i++) {
+                    h(i, k) = dot<Real>(w, basis_vector(i));
+                    axpy<Real>(-h(i, k), basis_vector(i), w);
+                }
+                const Real w_norm = norm<Real>(w);
+                for (std::size_t i = 0; w_norm > 0 && i < n; i++) {
+                    w[i] /= w_norm;
+                }
+                // rotate the new column with the earlier rotations, then zero its subdiagonal entry
+                for (std::size_t i = 0; i < k; i++) {
+                    const Real a = h(i, k), b = h(i + 1, k);
+                    h(i, k) = cosines[i] * a + sines[i] * b;
+                    h(i + 1, k) = -sines[i] * a + cosines[i] * b;
+                }
+                const Real radius = std::hypot(h(k, k), w_norm);
+                cosines[k] = radius > 0 ? h(k, k) / radius : Real(1);
+                sines[k] = radius > 0 ? w_norm / radius : Real(0);
+                h(k, k) = radius;
+                projected[k + 1] = -sines[k] * projected[k];
+                projected[k] *= cosines[k];
+                k++;
+                if (std::abs(projected[k]) <= tolerance || w_norm == 0) {
+                    break;
+                }
+            }
+            // back-substitute the k x k triangular system and add the correction
+            for (std::size_t i = k; i-- > 0;) {
+                Real sum = projected[i];
+                for (std::size_t j = i + 1; j < k; j++) {
+                    sum -= h(i, j) * projected[j];
+                }
+                projected[i] = h(i, i) != 0 ? sum / h(i, i) : Real(0);
+            }
+            for (std::size_t i = 0; i < k; i++) {
+                axpy<Real>(projected[i], basis_vector(i), step);
+            }
+            if (std::abs(projected[k]) <= tolerance) {
+                return;
+            }
+        }
+    }
+};
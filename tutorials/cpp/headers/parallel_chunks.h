@@ -0,0 +1,65 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// The thread loop behind every parallel header here: work is cut into chunks numbered 0 .. chunks - 1, and threads
+// take the next number from a shared counter until none are left, so a slow chunk never holds up the rest.
+//
+//   parallel_chunks(chunks, threads, work)           - work(c) for every chunk; the calling thread is one of the
+//                                                      threads, so threads = 1 runs everything in place
+//   parallel_chunks(chunks, threads, work, monitor)  - `threads` workers do the chunks while the calling thread runs
+//                                                      monitor(), e.g. to report progress on time however long a
+//                                                      chunk takes. The monitor returns when it has seen the work
+//                                                      finish (or cancelled it); the call then waits for the workers
+//
+// Which thread runs which chunk changes from run to run. Callers that want the same result for any thread count
+// write each chunk's result to its own slot and combine the slots in chunk order afterwards. No more threads are
+// started than there are chunks.
+
+namespace parallel_chunks_detail {
+
+template <typename Work>
+void take_chunks(std::atomic<std::size_t>& next, std::size_t chunks, Work& work) {
+    for (std::size_t c = next.fetch_add(1, std::memory_order_relaxed); c < chunks;
+         c = next.fetch_add(1, std::memory_order_relaxed)) {
+        work(c);
+    }
+}
+
+inline unsigned thread_count(std::size_t chunks, unsigned threads) {
+    return static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(threads, chunks)));
+}
+
+}  // namespace parallel_chunks_detail
+
+template <typename Work>
+void parallel_chunks(std::size_t chunks, unsigned threads, Work&& work) {
+    using namespace parallel_chunks_detail;
+    std::atomic<std::size_t> next{0};
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < thread_count(chunks, threads); t++) {
+        workers.emplace_back([&] { take_chunks(next, chunks, work); });
+    }
+    take_chunks(next, chunks, work);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+template <typename Work, typename Monitor>
+void parallel_chunks(std::size_t chunks, unsigned threads, Work&& work, Monitor&& monitor) {
+    using namespace parallel_chunks_detail;
+    std::atomic<std::size_t> next{0};
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < thread_count(chunks, threads); t++) {
+        workers.emplace_back([&] { take_chunks(next, chunks, work); });
+    }
+    monitor();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
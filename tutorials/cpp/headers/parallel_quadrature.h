@@ -0,0 +1,144 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "accumulators.h"
+#include "parallel_chunks.h"
+#include "quadrature.h"
+
+// Multithreaded fixed-partition quadrature for very large partition counts.
+//
+// The partitions are cut into chunks of a fixed size that does not depend on the thread count. Threads take chunks
+// from a shared counter (parallel_chunks.h), sum each one with the chosen accumulator, and store the partial sum in
+// the chunk's slot. The slots are then combined in chunk order, so the result is bitwise identical for any number of
+// threads and any scheduling.
+//
+// Long integrations are monitored from the calling thread instead of printing inside the loop: every
+// progress_interval it calls progress(partitions_done, partitions_total), and a false return cancels the
+// integration. Workers check for cancellation between chunks.
+
+struct ParallelOptions {
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t chunk = std::size_t(1) << 20;  // partitions per chunk; below 2^24 so chunk offsets stay exact in float
+    std::function<bool(std::size_t done, std::size_t total)> progress;
+    std::chrono::milliseconds progress_interval{100};
+};
+
+template <typename Real>
+struct ParallelResult {
+    Real value = 0;
+    bool cancelled = false;
+    std::size_t partitions_done = 0;
+};
+
+// Weighted sum of the sample points with global indices [first, last) for the given rule. Indices of the end points
+// of trapezoid and Simpson rules are left to the caller. Points are placed from a chunk origin computed in double,
+// so that the index offset within the chunk is small enough to be exact in Real.
+template <Rule rule, template <typename> class Accumulator, typename Real, typename F>
+Real partial_sum(F& f, Real a, Real h, std::size_t first, std::size_t last) {
+    const Real shift = (rule == Rule::midpoint) ? Real(0.5) : Real(0);
+    const Real origin = static_cast<Real>(static_cast<double>(a) + (static_cast<double>(first) + shift) * h);
+    if constexpr (rule == Rule::simpson) {
+        Accumulator<Real> odd, even;
+        for (std::size_t i = first; i < last; i++) {
+            Real y = f(origin + static_cast<Real>(i - first) * h);
+            if (i % 2 == 1) {
+                odd.add(y);
+            } else {
+                even.add(y);
+            }
+        }
+        return Real(4) * odd.total() + Real(2) * even.total();
+    } else {
+        Accumulator<Real> sum;
+        for (std::size_t i = first; i < last; i++) {
+            sum.add(f(origin + static_cast<Real>(i - first) * h));
+        }
+        return sum.total();
+    }
+}
+
+template <Rule rule, template <typename> class Accumulator = KahanSum, typename Real, typename F>
+ParallelResult<Real> integrate_parallel(F&& f, Real a, Real b, std::size_t partitions,
+                                        const ParallelOptions& options = {}) {
+    ParallelResult<Real> result;
+    if (partitions == 0) {
+        return result;
+    }
+    if constexpr (rule == Rule::simpson) {
+        partitions += partitions % 2;
+    }
+    const Real h = (b - a) / static_cast<Real>(partitions);
+
+    // sample indices [first, last); trapezoid and Simpson add their end points afterwards
+    std::size_t first = 0, last = partitions;
+    if constexpr (rule == Rule::right) {
+        first = 1;
+        last = partitions + 1;
+    } else if constexpr (rule == Rule::trapezoid || rule == Rule::simpson) {
+        first = 1;
+    }
+    const std::size_t chunk = std::max<std::size_t>(2, options.chunk);
+    const std::size_t chunks = (last - first + chunk - 1) / chunk;
+
+    std::vector<Real> partials(chunks, Real(0));
+    std::atomic<std::size_t> finished{0};  // partitions summed so far
+    std::atomic<bool> cancel{false};
+    auto work = [&](std::size_t c) {
+        if (cancel.load(std::memory_order_relaxed)) {
+            return;  // chunks left after a cancellation are skipped
+        }
+        std::size_t lo = first + c * chunk;
+        std::size_t hi = std::min(last, lo + chunk);
+        partials[c] = partial_sum<rule, Accumulator>(f, a, h, lo, hi);
+        finished.fetch_add(hi - lo, std::memory_order_relaxed);
+    };
+
+    const unsigned threads = std::max(1u, options.threads);
+    if (!options.progress) {
+        parallel_chunks(chunks, threads, work);
+    } else {
+        // the calling thread only monitors, so progress reports arrive on time however long a chunk takes
+        parallel_chunks(chunks, threads, work, [&] {
+            const std::size_t total = last - first;
+            auto last_report = std::chrono::steady_clock::now();
+            while (finished.load() < total) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                auto now = std::chrono::steady_clock::now();
+                if (now - last_report < options.progress_interval) {
+                    continue;
+                }
+                last_report = now;
+                if (!options.progress(finished.load(), total)) {
+                    cancel = true;
+                    return;
+                }
+            }
+            options.progress(total, total);
+        });
+    }
+
+    result.partitions_done = finished.load();
+    result.cancelled = cancel.load();
+    if (result.cancelled) {
+        return result;
+    }
+    Accumulator<Real> sum;
+    for (Real partial : partials) {
+        sum.add(partial);
+    }
+    Real total = sum.total();
+    if constexpr (rule == Rule::trapezoid) {
+        total += (f(a) + f(b)) / Real(2);
+    } else if constexpr (rule == Rule::simpson) {
+        total = (total + f(a) + f(b)) / Real(3);
+    }
+    result.value = total * h;
+    return result;
+}
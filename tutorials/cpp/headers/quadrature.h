@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+
+#include "accumulators.h"
+
+// Fixed-partition quadrature rules. The integrand is a template parameter, so a lambda or functor is inlined into
+// the loop; nothing in the loop does I/O.
+//
+//   integrate<Rule::simpson>([](double x) { return x * x; }, 0.0, 1.0, 1000);
+//
+// Sample points are computed as x_i = a + i * h rather than by repeatedly adding h, which would let rounding error
+// build up over the partitions. b < a is allowed and gives the negated integral, as in riemann_integral.cpp.
+//
+// Everything here is constexpr, so an integral of a constexpr integrand can be evaluated at compile time.
+//
+// The running sum is a policy from accumulators.h, NaiveSum by default; KahanSum, NeumaierSum or PairwiseSum keep
+// float integrations accurate at very large partition counts:
+//
+//   integrate<Rule::left, KahanSum>(f, 0.0f, 1.0f, 1000000000);
+
+enum class Rule { left, right, midpoint, trapezoid, simpson };
+
+template <Rule rule, template <typename> class Accumulator = NaiveSum, typename Real, typename F>
+constexpr Real integrate(F&& f, Real a, Real b, std::size_t partitions) {
+    if (partitions == 0) {
+        return Real(0);
+    }
+    if constexpr (rule == Rule::simpson) {
+        // Simpson's rule pairs up partitions, so an odd count is rounded up
+        partitions += partitions % 2;
+    }
+    const Real h = (b - a) / static_cast<Real>(partitions);
+    Accumulator<Real> sum;
+
+    if constexpr (rule == Rule::left) {
+        for (std::size_t i = 0; i < partitions; i++) {
+            sum.add(f(a + static_cast<Real>(i) * h));
+        }
+        return sum.total() * h;
+    } else if constexpr (rule == Rule::right) {
+        for (std::size_t i = 1; i <= partitions; i++) {
+            sum.add(f(a + static_cast<Real>(i) * h));
+        }
+        return sum.total() * h;
+    } else if constexpr (rule == Rule::midpoint) {
+        for (std::size_t i = 0; i < partitions; i++) {
+            sum.add(f(a + (static_cast<Real>(i) + Real(0.5)) * h));
+        }
+        return sum.total() * h;
+    } else if constexpr (rule == Rule::trapezoid) {
+        for (std::size_t i = 1; i < partitions; i++) {
+            sum.add(f(a + static_cast<Real>(i) * h));
+        }
+        return (sum.total() + (f(a) + f(b)) / Real(2)) * h;
+    } else {
+        // weights 1, 4, 2, 4, ..., 2, 4, 1 times h / 3
+        Accumulator<Real> odd;
+        for (std::size_t i = 1; i < partitions; i += 2) {
+            odd.add(f(a + static_cast<Real>(i) * h));
+        }
+        for (std::size_t i = 2; i < partitions; i += 2) {
+            sum.add(f(a + static_cast<Real>(i) * h));
+        }
+        return (f(a) + f(b) + Real(4) * odd.total() + Real(2) * sum.total()) * h / Real(3);
+    }
+}
+
+// Same as above with the rule chosen at run time.
+template <template <typename> class Accumulator = NaiveSum, typename Real, typename F>
+constexpr Real integrate(F&& f, Real a, Real b, std::size_t partitions, Rule rule) {
+    switch (rule) {
+        case Rule::left: return integrate<Rule::left, Accumulator>(f, a, b, partitions);
+        case Rule::right: return integrate<Rule::right, Accumulator>(f, a, b, partitions);
+        case Rule::midpoint: return integrate<Rule::midpoint, Accumulator>(f, a, b, partitions);
+        case Rule::trapezoid: return integrate<Rule::trapezoid, Accumulator>(f, a, b, partitions);
+        case Rule::simpson: return integrate<Rule::simpson, Accumulator>(f, a, b, partitions);
+    }
+    return Real(0);
+}
+
+constexpr const char* rule_name(Rule rule) {
+    switch (rule) {
+        case Rule::left: return "left";
+        case Rule::right: return "right";
+        case Rule::midpoint: return "midpoint";
+        case Rule::trapezoid: return "trapezoid";
+        case Rule::simpson: return "simpson";
+    }
+    return "unknown";
+}
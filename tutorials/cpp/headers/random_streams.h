@@ -0,0 +1,331 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// Random number streams for Monte Carlo work, and block generation of uniform, normal and exponential variates.
+//
+//   Philox4x32    - counter-based (Salmon et al., Random123): output n of stream s is a pure function of (seed, s, n),
+//                   so every thread or chunk gets an independent stream by number and can seek anywhere for free.
+//                   Consecutive counters are independent, so a block of them is generated in one vectorised loop
+//   Xoshiro256pp  - xoshiro256++ (Blackman and Vigna): tiny, fast, sequential. jump() advances 2^128 outputs and
+//                   long_jump() 2^192, which hands out non-overlapping streams
+//   XoshiroLanes  - several xoshiro256++ streams, each a jump() apart, stepped in lockstep so the compiler can put
+//                   them in one vector register
+//
+// Each generator has fill(std::span<std::uint64_t>). The fill_uniform, fill_normal and fill_exponential functions
+// turn such a block into variates with branch-free code (including the log, sin and cos kernels below), which GCC
+// vectorises at -O3.
+
+inline std::uint64_t splitmix64(std::uint64_t& state) {
+    std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+class Philox4x32 {
+public:
+    Philox4x32(std::uint64_t seed, std::uint64_t stream = 0, std::uint64_t position = 0)
+        : key0(static_cast<std::uint32_t>(seed)), key1(static_cast<std::uint32_t>(seed >> 32)),
+          stream_lo(static_cast<std::uint32_t>(stream)), stream_hi(static_cast<std::uint32_t>(stream >> 32)),
+          counter(position) {}
+
+    // Jump to block n of the stream; each block is 128 bits, i.e. two 64-bit outputs.
+    void seek(std::uint64_t block) { counter = block; }
+    std::uint64_t position() const { return counter; }
+
+    // The 128-bit block for counter (n, stream) under this generator's key, as four 32-bit words.
+    void block(std::uint64_t n, std::uint32_t out[4]) const {
+        std::uint32_t c0 = static_cast<std::uint32_t>(n), c1 = static_cast<std::uint32_t>(n >> 32);
+        std::uint32_t c2 = stream_lo, c3 = stream_hi;
+        std::uint32_t k0 = key0, k1 = key1;
+        for (int round = 0; round < 10; round++) {
+            std::uint64_t p0 = std::uint64_t(0xD2511F53u) * c0;
+            std::uint64_t p1 = std::uint64_t(0xCD9E8D57u) * c2;
+            std::uint32_t n0 = static_cast<std::uint32_t>(p1 >> 32) ^ c1 ^ k0;
+            std::uint32_t n2 = static_cast<std::uint32_t>(p0 >> 32) ^ c3 ^ k1;
+            c0 = n0;
+            c1 = static_cast<std::uint32_t>(p1);
+            c2 = n2;
+            c3 = static_cast<std::uint32_t>(p0);
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+        out[0] = c0;
+        out[1] = c1;
+        out[2] = c2;
+        out[3] = c3;
+    }
+
+    std::uint64_t operator()() {
+        if (!spare_ready) {
+            std::uint32_t w[4];
+            block(counter++, w);
+            spare = (std::uint64_t(w[3]) << 32) | w[2];
+            spare_ready = true;
+            return (std::uint64_t(w[1]) << 32) | w[0];
+        }
+        spare_ready = false;
+        return spare;
+    }
+
+    // Two outputs per counter; the loop over counters has no dependence between iterations.
+    void fill(std::span<std::uint64_t> out) {
+        const std::size_t pairs = out.size() / 2;
+        const std::uint64_t base = counter;
+        for (std::size_t i = 0; i < pairs; i++) {
+            std::uint32_t w[4];
+            block(base + i, w);
+            out[2 * i] = (std::uint64_t(w[1]) << 32) | w[0];
+            out[2 * i + 1] = (std::uint64_t(w[3]) << 32) | w[2];
+        }
+        counter += pairs;
+        if (out.size() % 2 == 1) {
+            out.back() = (*this)();
+        }
+    }
+
+private:
+    std::uint32_t key0, key1, stream_lo, stream_hi;
+    std::uint64_t counter;
+    std::uint64_t spare = 0;
+    bool spare_ready = false;
+};
+
+class Xoshiro256pp {
+public:
+    explicit Xoshiro256pp(std::uint64_t seed) {
+        for (std::uint64_t& word : s) {
+            word = splitmix64(seed);
+        }
+    }
+
+    std::uint64_t operator()() {
+        const std::uint64_t result = std::rotl(s[0] + s[3], 23) + s[0];
+        const std::uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = std::rotl(s[3], 45);
+        return result;
+    }
+
+    void fill(std::span<std::uint64_t> out) {
+        for (std::uint64_t& x : out) {
+            x = (*this)();
+        }
+    }
+
+    // Equivalent to 2^128 calls; 2^128 non-overlapping streams of that length.
+    void jump() {
+        static constexpr std::uint64_t polynomial[] = {0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull,
+                                                       0xa9582618e03fc9aaull, 0x39abdc4529b1661cull};
+        apply(polynomial);
+    }
+
+    // Equivalent to 2^192 calls; 2^64 starting points, each with room for 2^64 jump() streams.
+    void long_jump() {
+        static constexpr std::uint64_t polynomial[] = {0x76e15d3efefdcbbfull, 0xc5004e441c522fb3ull,
+                                                       0x77710069854ee241ull, 0x39109bb02acbe635ull};
+        apply(polynomial);
+    }
+
+private:
+    friend class XoshiroLanes;
+    std::uint64_t s[4];
+
+    void apply(const std::uint64_t (&polynomial)[4]) {
+        std::uint64_t t[4] = {0, 0, 0, 0};
+        for (std::uint64_t word : polynomial) {
+            for (int b = 0; b < 64; b++) {
+                if (word & (std::uint64_t(1) << b)) {
+                    for (int i = 0; i < 4; i++) {
+                        t[i] ^= s[i];
+                    }
+                }
+                (*this)();
+            }
+        }
+        for (int i = 0; i < 4; i++) {
+            s[i] = t[i];
+        }
+    }
+};
+
+// lanes xoshiro256++ generators, lane k being the seed's stream after k jumps. The state is stored lane-minor, so
+// one step of every lane is a handful of vector instructions. fill() interleaves the lanes' outputs.
+class XoshiroLanes {
+public:
+    static constexpr std::size_t lanes = 8;
+
+    explicit XoshiroLanes(std::uint64_t seed) {
+        Xoshiro256pp g(seed);
+        for (std::size_t k = 0; k < lanes; k++) {
+            for (int i = 0; i < 4; i++) {
+                s[i][k] = g.s[i];
+            }
+            g.jump();
+        }
+    }
+
+    void fill(std::span<std::uint64_t> out) {
+        std::size_t i = 0;
+        for (; i + lanes <= out.size(); i += lanes) {
+            step(&out[i]);
+        }
+        if (i < out.size()) {
+            std::uint64_t rest[lanes];
+            step(rest);
+            for (std::size_t k = 0; i + k < out.size(); k++) {
+                out[i + k] = rest[k];
+            }
+        }
+    }
+
+private:
+    std::uint64_t s[4][lanes];
+
+    void step(std::uint64_t* out) {
+        for (std::size_t k = 0; k < lanes; k++) {
+            out[k] = std::rotl(s[0][k] + s[3][k], 23) + s[0][k];
+            const std::uint64_t t = s[1][k] << 17;
+            s[2][k] ^= s[0][k];
+            s[3][k] ^= s[1][k];
+            s[1][k] ^= s[2][k];
+            s[0][k] ^= s[3][k];
+            s[2][k] ^= t;
+            s[3][k] = std::rotl(s[3][k], 45);
+        }
+    }
+};
+
+// Branch-free kernels for the distributions, accurate to a few ulp over the ranges used here.
+namespace random_detail {
+
+// Top 52 bits to the centre of one of 2^52 equal cells of (0, 1); never exactly 0 or 1. The bits become the
+// mantissa of a number in [1, 2), since AVX2 has no vector uint64 to double conversion.
+inline double to_unit(std::uint64_t bits) {
+    return std::bit_cast<double>((bits >> 12) | 0x3ff0000000000000ull) - (1.0 - 0x1p-53);
+}
+
+// Natural log of a positive normal double: x = 2^e m with m in [sqrt(1/2), sqrt(2)), and
+// log m = 2 atanh(s) = 2 (s + s^3/3 + s^5/5 + ...) with s = (m - 1)/(m + 1), |s| < 0.172.
+inline double log_positive(double x) {
+    std::uint64_t bits = std::bit_cast<std::uint64_t>(x);
+    // the exponent through the 2^52 magic number, which avoids an int64 to double conversion AVX2 lacks
+    double e = std::bit_cast<double>((bits >> 52) | 0x4330000000000000ull) - (0x1p52 + 1023.0);
+    double m = std::bit_cast<double>((bits & 0x000fffffffffffffull) | 0x3ff0000000000000ull);
+    const bool high = m > 1.4142135623730951;
+    m = high ? 0.5 * m : m;
+    e = high ? e + 1.0 : e;
+    const double s = (m - 1.0) / (m + 1.0);
+    const double z = s * s;
+    double p = 2.0 / 25;
+    p = p * z + 2.0 / 23;
+    p = p * z + 2.0 / 21;
+    p = p * z + 2.0 / 19;
+    p = p * z + 2.0 / 17;
+    p = p * z + 2.0 / 15;
+    p = p * z + 2.0 / 13;
+    p = p * z + 2.0 / 11;
+    p = p * z + 2.0 / 9;
+    p = p * z + 2.0 / 7;
+    p = p * z + 2.0 / 5;
+    p = p * z + 2.0 / 3;
+    p = p * z + 2.0;
+    return e * 0.6931471805599453 + (e * 2.3190468138462996e-17 + s * p);
+}
+
+// sin and cos of 2 pi u for u in [0, 1): u is reduced to the nearest quarter turn q and a remainder |r| <= pi/4,
+// where Taylor polynomials converge fast, and the quadrant picks signs and swaps.
+inline void sincos_turn(double u, double& sin_out, double& cos_out) {
+    // round to the nearest integer with the 1.5 * 2^52 trick (floor does not vectorise without -fno-trapping-math);
+    // the low mantissa bits of the sum are then the quadrant
+    const double t = 4.0 * u;
+    const double shifted = t + 0x1.8p52;
+    const std::uint64_t quadrant = std::bit_cast<std::uint64_t>(shifted) & 3;
+    const double r = (t - (shifted - 0x1.8p52)) * 1.5707963267948966;
+    const double z = r * r;
+    double sp = -1.0 / 1307674368000.0;
+    sp = sp * z + 1.0 / 6227020800.0;
+    sp = sp * z - 1.0 / 39916800.0;
+    sp = sp * z + 1.0 / 362880.0;
+    sp = sp * z - 1.0 / 5040.0;
+    sp = sp * z + 1.0 / 120.0;
+    sp = sp * z - 1.0 / 6.0;
+    const double sin_r = r + r * z * sp;
+    double cp = 1.0 / 20922789888000.0;
+    cp = cp * z - 1.0 / 87178291200.0;
+    cp = cp * z + 1.0 / 479001600.0;
+    cp = cp * z - 1.0 / 3628800.0;
+    cp = cp * z + 1.0 / 40320.0;
+    cp = cp * z - 1.0 / 720.0;
+    cp = cp * z + 1.0 / 24.0;
+    cp = cp * z - 0.5;
+    const double cos_r = 1.0 + z * cp;
+    // odd quadrants swap sin and cos; the sign bits flip in quadrants 2, 3 for sin and 1, 2 for cos
+    const bool odd = (quadrant & 1) != 0;
+    const double s = odd ? cos_r : sin_r;
+    const double c = odd ? sin_r : cos_r;
+    sin_out = std::bit_cast<double>(std::bit_cast<std::uint64_t>(s) ^ ((quadrant & 2) << 62));
+    cos_out = std::bit_cast<double>(std::bit_cast<std::uint64_t>(c) ^ (((quadrant + 1) & 2) << 62));
+}
+
+constexpr std::size_t block = 256;
+
+}  // namespace random_detail
+
+// Uniform on (0, 1).
+template <typename Generator>
+void fill_uniform(Generator& gen, std::span<double> out) {
+    std::uint64_t bits[random_detail::block];
+    for (std::size_t first = 0; first < out.size(); first += random_detail::block) {
+        const std::size_t n = std::min(random_detail::block, out.size() - first);
+        gen.fill(std::span<std::uint64_t>(bits, n));
+        for (std::size_t i = 0; i < n; i++) {
+            out[first + i] = random_detail::to_unit(bits[i]);
+        }
+    }
+}
+
+// Standard normal, by the Box-Muller transform: each pair of uniforms gives a pair of independent normals.
+template <typename Generator>
+void fill_normal(Generator& gen, std::span<double> out) {
+    constexpr std::size_t half = random_detail::block / 2;
+    std::uint64_t bits[random_detail::block];
+    double pair[random_detail::block];
+    for (std::size_t first = 0; first < out.size(); first += random_detail::block) {
+        const std::size_t n = std::min(random_detail::block, out.size() - first);
+        gen.fill(std::span<std::uint64_t>(bits, random_detail::block));
+        for (std::size_t i = 0; i < half; i++) {
+            const double radius = std::sqrt(-2.0 * random_detail::log_positive(random_detail::to_unit(bits[i])));
+            double s, c;
+            random_detail::sincos_turn(random_detail::to_unit(bits[half + i]), s, c);
+            pair[i] = radius * c;
+            pair[half + i] = radius * s;
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            out[first + i] = pair[i];
+        }
+    }
+}
+
+// Exponential with unit rate, by inversion: -log u.
+template <typename Generator>
+void fill_exponential(Generator& gen, std::span<double> out) {
+    std::uint64_t bits[random_detail::block];
+    for (std::size_t first = 0; first < out.size(); first += random_detail::block) {
+        const std::size_t n = std::min(random_detail::block, out.size() - first);
+        gen.fill(std::span<std::uint64_t>(bits, n));
+        for (std::size_t i = 0; i < n; i++) {
+            out[first + i] = -random_detail::log_positive(random_detail::to_unit(bits[i]));
+        }
+    }
+}
@@ -1,55 +1,49 @@
-#include <iostream>
-#include <cmath>
-#include <vector>
+#pragma once
 
-float continuous_function(float x, float m, float c) {
-    return m * x + c;
+#include <cstddef>
+
+#include "accumulators.h"
+#include "interpolation.h"
+#include "quadrature.h"
+#include "roots.h"
+
+// Header-only numerics library for the tutorials: quadrature (quadrature.h, accumulators.h), root finding
+// (roots.h) and interpolation (interpolation.h). Everything is a template and usable by including this header.
+//
+// Templates taking the integrand as a functor are instantiated afresh for every lambda, which is what lets the
+// integrand inline. For plain functions the entry points below take a function pointer instead, so one compiled
+// copy per floating-point type serves every caller. Building with -DNUMERICS_EXTERN_TEMPLATES declares the float and
+// double copies extern; they are then compiled once in numerics_instantiations.cpp instead of in every translation
+// unit that uses them:
+//
+//   g++ -std=c++20 -O2 -DNUMERICS_EXTERN_TEMPLATES program.cpp numerics_instantiations.cpp
+
+template <typename Real>
+using ScalarFunction = Real (*)(Real);
+
+template <typename Real>
+Real integrate_function(ScalarFunction<Real> f, Real a, Real b, std::size_t partitions, Rule rule) {
+    return integrate<KahanSum>(f, a, b, partitions, rule);
+}
+
+template <typename Real>
+RootResult<Real> bisection_function(ScalarFunction<Real> f, Real lo, Real hi, Real tolerance) {
+    return bisection(f, lo, hi, tolerance);
+}
+
+template <typename Real>
+RootResult<Real> newton_function(ScalarFunction<Real> f, ScalarFunction<Real> df, Real x0, Real tolerance) {
+    return newton(f, df, x0, tolerance);
 }
 
-int main() {
-    std::cout << "Riemann Integral -- First Principles" << std::endl;
-    std::cout << "This demonstration will show the calculation of the Riemann Integral from first principles." << std::endl;
-    // first, declare the function to calculate the integral of
-    float x = 5;
-    float m = -1;
-    float c = 0;
-
-    float y = continuous_function(x,m,c);
-    std::cout << "Result: " << y << std::endl; 
-    float x_0 = 5;
-    float x_T = 0;
-    // int y_0 = continuous_function(x_0,m,c);
-    // int y_T = continuous_function(x_T,m,c);
-    
-    std::vector<float> x_array;
-    std::vector<float> y_array;
-    x_array.push_back(0);
-    y_array.push_back(continuous_function(0,m,c));
-    
-    
-    float no_of_partitions = 1000;
-    float h = (x_T - x_0)/no_of_partitions;
-    std::cout << "Partititon size: " << h << std::endl;
-
-    std::cout << "Initialising xt as initial x at time t=0" << std::endl;
-    float xt = x_0;
-    // float yt = y_0;
-    float area = 0.0;
-
-    for (int i = 1; i < no_of_partitions + 1; i++) {
-        std::cout << "Partititon number: " << i << std::endl;
-        float xi = xt + h;
-        float yt = continuous_function(xt, m, c);
-        // float yi = continuous_function(xi, m, c);
-        area += yt * h;
-        std::cout << "Total area: " << area << std::endl;
-        // std::cout << "X("<< i - 1 << ":" << i << "): " << xi << std::endl;
-        // std::cout << "Y(" << i - 1 << ":" << i << "): " << yi << std::endl;
-        // x_array.push_back(xi);
-        // y_array.push_back(yi);
-        xt = xi;
-    }
-    std::cout << "Area computed. Final total: " << area << std::endl;
-
-    return 0;
-}
\ No newline at end of file
+#ifdef NUMERICS_EXTERN_TEMPLATES
+extern template float integrate_function<float>(ScalarFunction<float>, float, float, std::size_t, Rule);
+extern template double integrate_function<double>(ScalarFunction<double>, double, double, std::size_t, Rule);
+extern template RootResult<float> bisection_function<float>(ScalarFunction<float>, float, float, float);
+extern template RootResult<double> bisection_function<double>(ScalarFunction<double>, double, double, double);
+extern template RootResult<float> newton_function<float>(ScalarFunction<float>, ScalarFunction<float>, float, float);
+extern template RootResult<double> newton_function<double>(ScalarFunction<double>, ScalarFunction<double>, double,
+                                                           double);
+extern template class CubicSpline<float>;
+extern template class CubicSpline<double>;
+#endif
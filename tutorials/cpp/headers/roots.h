@@ -0,0 +1,329 @@
+#pragma once
+
+#include <limits>
+
+// Scalar root finding. The routines are constexpr, so a root of a constexpr function can be found at compile time:
+//
+//   constexpr auto r = bisection([](double x) { return x * x - 2.0; }, 0.0, 2.0, 1e-12);
+//   static_assert(r.converged);
+//
+// Bracketing methods, given [lo, hi] with f(lo) and f(hi) of opposite sign, always converge:
+//   bisection - halves the bracket; one bit per evaluation
+//   brent     - inverse quadratic / secant steps, falling back to bisection when they stall (Brent 1973)
+//   itp       - interpolate, truncate, project (Oliveira and Takahashi 2020): secant-like speed on smooth f, and never
+//               more evaluations than bisection needs for the same tolerance
+// Open methods start from a guess and converge faster when they converge at all:
+//   secant    - two starting points, no derivative
+//   newton    - f and f'; with expression.h the derivative comes from derivative(f)
+//   halley    - f, f' and f''; cubic convergence
+//
+// Every method stops when the step (or half the bracket) is within criteria.x_tolerance or |f(x)| is within
+// criteria.f_tolerance, and gives up after criteria.max_iterations. Nothing allocates or prints, so the solvers are
+// cheap enough to call millions of times in a calibration loop.
+
+template <typename Real>
+struct RootResult {
+    Real root = 0;
+    int iterations = 0;
+    bool converged = false;
+    int evaluations = 0;  // calls of f (and of its derivatives, counted once per point)
+};
+
+template <typename Real>
+struct RootCriteria {
+    Real x_tolerance = 0;
+    Real f_tolerance = 0;
+    int max_iterations = 100;
+};
+
+template <typename Real>
+constexpr Real magnitude(Real x) {
+    return x < 0 ? -x : x;
+}
+
+namespace roots_detail {
+
+template <typename Real>
+constexpr bool same_sign(Real a, Real b) {
+    return (a < 0) == (b < 0);
+}
+
+template <typename Real>
+constexpr bool small_residual(Real fx, const RootCriteria<Real>& criteria) {
+    return fx == 0 || magnitude(fx) <= criteria.f_tolerance;
+}
+
+// Checks the end points of a bracket. Returns true, with result filled in, when one of them is already a root or
+// the bracket has no sign change.
+template <typename Real>
+constexpr bool check_bracket(Real lo, Real hi, Real f_lo, Real f_hi, const RootCriteria<Real>& criteria,
+                             RootResult<Real>& result) {
+    result.evaluations = 2;
+    if (small_residual(f_lo, criteria)) {
+        result.root = lo;
+        result.converged = true;
+        return true;
+    }
+    if (small_residual(f_hi, criteria)) {
+        result.root = hi;
+        result.converged = true;
+        return true;
+    }
+    return same_sign(f_lo, f_hi);  // no sign change, so no bracketed root
+}
+
+}  // namespace roots_detail
+
+// Halves a bracket [lo, hi] with f(lo) and f(hi) of opposite sign.
+template <typename Real, typename F>
+constexpr RootResult<Real> bisection(F&& f, Real lo, Real hi, const RootCriteria<Real>& criteria) {
+    RootResult<Real> result;
+    Real f_lo = f(lo);
+    if (roots_detail::check_bracket(lo, hi, f_lo, f(hi), criteria, result)) {
+        return result;
+    }
+    for (result.iterations = 1; result.iterations <= criteria.max_iterations; result.iterations++) {
+        Real mid = lo + (hi - lo) / 2;
+        Real f_mid = f(mid);
+        result.evaluations++;
+        if (roots_detail::small_residual(f_mid, criteria) || magnitude(hi - lo) / 2 < criteria.x_tolerance) {
+            result.root = mid;
+            result.converged = true;
+            return result;
+        }
+        if (roots_detail::same_sign(f_mid, f_lo)) {
+            lo = mid;
+            f_lo = f_mid;
+        } else {
+            hi = mid;
+        }
+    }
+    result.iterations = criteria.max_iterations;
+    result.root = lo + (hi - lo) / 2;
+    return result;
+}
+
+template <typename Real, typename F>
+constexpr RootResult<Real> bisection(F&& f, Real lo, Real hi, Real tolerance, int max_iterations = 200) {
+    return bisection(f, lo, hi, RootCriteria<Real>{tolerance, Real(0), max_iterations});
+}
+
+// Brent's method (zeroin). b is the best estimate, a the previous one, and c the point bracketing the root with b.
+template <typename Real, typename F>
+constexpr RootResult<Real> brent(F&& f, Real lo, Real hi, const RootCriteria<Real>& criteria) {
+    RootResult<Real> result;
+    Real a = lo, b = hi;
+    Real fa = f(a), fb = f(b);
+    if (roots_detail::check_bracket(a, b, fa, fb, criteria, result)) {
+        return result;
+    }
+    Real c = a, fc = fa;
+    Real d = b - a, e = d;
+    for (result.iterations = 1; result.iterations <= criteria.max_iterations; result.iterations++) {
+        if (roots_detail::same_sign(fb, fc)) {
+            c = a;
+            fc = fa;
+            d = e = b - a;
+        }
+        if (magnitude(fc) < magnitude(fb)) {
+            a = b;
+            b = c;
+            c = a;
+            fa = fb;
+            fb = fc;
+            fc = fa;
+        }
+        const Real epsilon = Real(2) * std::numeric_limits<Real>::epsilon() * magnitude(b);
+        const Real tolerance = epsilon + criteria.x_tolerance;
+        const Real half = (c - b) / 2;
+        if (magnitude(half) <= tolerance || roots_detail::small_residual(fb, criteria)) {
+            result.root = b;
+            result.converged = true;
+            return result;
+        }
+        if (magnitude(e) >= tolerance && magnitude(fa) > magnitude(fb)) {
+            // interpolation: secant when only two distinct points, inverse quadratic otherwise
+            Real p, q;
+            const Real s = fb / fa;
+            if (a == c) {
+                p = 2 * half * s;
+                q = 1 - s;
+            } else {
+                const Real t = fa / fc, r = fb / fc;
+                p = s * (2 * half * t * (t - r) - (b - a) * (r - 1));
+                q = (t - 1) * (r - 1) * (s - 1);
+            }
+            if (p > 0) {
+                q = -q;
+            } else {
+                p = -p;
+            }
+            // accept the step only if it stays well inside the bracket and shrinks fast enough
+            if (2 * p < 3 * half * q - magnitude(tolerance * q) && p < magnitude(e * q / 2)) {
+                e = d;
+                d = p / q;
+            } else {
+                d = half;
+                e = d;
+            }
+        } else {
+            d = half;
+            e = d;
+        }
+        a = b;
+        fa = fb;
+        b += magnitude(d) > tolerance ? d : (half > 0 ? tolerance : -tolerance);
+        fb = f(b);
+        result.evaluations++;
+    }
+    result.iterations = criteria.max_iterations;
+    result.root = b;
+    return result;
+}
+
+// ITP with the recommended parameters k1 = 0.2 / (hi - lo), k2 = 2, n0 = 1. ITP sizes its projection radius from
+// x_tolerance, so without one (x_tolerance <= 0) it uses a few ulps of the bracket ends, as brent does.
+template <typename Real, typename F>
+constexpr RootResult<Real> itp(F&& f, Real lo, Real hi, const RootCriteria<Real>& criteria) {
+    RootResult<Real> result;
+    Real a = lo, b = hi;
+    Real fa = f(a), fb = f(b);
+    if (roots_detail::check_bracket(a, b, fa, fb, criteria, result)) {
+        return result;
+    }
+    const Real ends = magnitude(a) > magnitude(b) ? magnitude(a) : magnitude(b);
+    const Real ulps = Real(4) * std::numeric_limits<Real>::epsilon() * ends;
+    const Real epsilon = criteria.x_tolerance > 0 ? criteria.x_tolerance
+                         : ulps > 0                 ? ulps
+                                                    : std::numeric_limits<Real>::min();
+    const Real k1 = Real(0.2) / magnitude(b - a);
+    // 2^n_max with n_max = ceil(log2((b - a) / (2 epsilon))) + n0; the projection radius shrinks by half each step
+    Real radius_scale = 1;
+    while (radius_scale * epsilon < magnitude(b - a) / 2) {
+        radius_scale *= 2;
+    }
+    radius_scale *= 2;
+    for (result.iterations = 1; result.iterations <= criteria.max_iterations; result.iterations++) {
+        const Real width = b - a;
+        if (magnitude(width) / 2 <= epsilon) {
+            break;
+        }
+        const Real mid = a + width / 2;
+        const Real r = epsilon * radius_scale - magnitude(width) / 2;
+        const Real delta = k1 * width * width;
+        // interpolate
+        const Real regula_falsi = (b * fa - a * fb) / (fa - fb);
+        // truncate towards the midpoint
+        const Real sigma = (mid - regula_falsi) < 0 ? Real(-1) : Real(1);
+        const Real truncated = delta <= magnitude(mid - regula_falsi) ? regula_falsi + sigma * delta : mid;
+        // project into the minmax disc around the midpoint
+        const Real x = magnitude(truncated - mid) <= r ? truncated : mid - sigma * r;
+        const Real fx = f(x);
+        result.evaluations++;
+        radius_scale /= 2;
+        if (roots_detail::small_residual(fx, criteria)) {
+            result.root = x;
+            result.converged = true;
+            return result;
+        }
+        if (roots_detail::same_sign(fx, fa)) {
+            a = x;
+            fa = fx;
+        } else {
+            b = x;
+            fb = fx;
+        }
+    }
+    result.root = a + (b - a) / 2;
+    result.converged = magnitude(b - a) / 2 <= epsilon;
+    result.iterations = result.converged ? result.iterations : criteria.max_iterations;
+    return result;
+}
+
+// Secant method from x0 and x1.
+template <typename Real, typename F>
+constexpr RootResult<Real> secant(F&& f, Real x0, Real x1, const RootCriteria<Real>& criteria) {
+    RootResult<Real> result{x1, 0, false, 2};
+    Real f0 = f(x0), f1 = f(x1);
+    if (roots_detail::small_residual(f1, criteria)) {
+        result.converged = true;
+        return result;
+    }
+    for (result.iterations = 1; result.iterations <= criteria.max_iterations; result.iterations++) {
+        if (f1 == f0) {
+            return result;  // flat secant
+        }
+        const Real step = f1 * (x1 - x0) / (f1 - f0);
+        x0 = x1;
+        f0 = f1;
+        x1 -= step;
+        f1 = f(x1);
+        result.evaluations++;
+        result.root = x1;
+        if (magnitude(step) <= criteria.x_tolerance || roots_detail::small_residual(f1, criteria)) {
+            result.converged = true;
+            return result;
+        }
+    }
+    result.iterations = criteria.max_iterations;
+    return result;
+}
+
+// Newton-Raphson from x0 with an explicit derivative. Fails on a zero derivative.
+template <typename Real, typename F, typename DF>
+constexpr RootResult<Real> newton(F&& f, DF&& df, Real x0, const RootCriteria<Real>& criteria) {
+    RootResult<Real> result{x0, 0, false, 0};
+    for (result.iterations = 1; result.iterations <= criteria.max_iterations; result.iterations++) {
+        const Real fx = f(result.root);
+        result.evaluations++;
+        if (roots_detail::small_residual(fx, criteria)) {
+            result.converged = true;
+            return result;
+        }
+        const Real slope = df(result.root);
+        if (slope == 0) {
+            return result;
+        }
+        const Real step = fx / slope;
+        result.root -= step;
+        if (magnitude(step) <= criteria.x_tolerance) {
+            result.converged = true;
+            return result;
+        }
+    }
+    result.iterations = criteria.max_iterations;
+    return result;
+}
+
+template <typename Real, typename F, typename DF>
+constexpr RootResult<Real> newton(F&& f, DF&& df, Real x0, Real tolerance, int max_iterations = 50) {
+    return newton(f, df, x0, RootCriteria<Real>{tolerance, Real(0), max_iterations});
+}
+
+// Halley's method from x0 with the first and second derivatives.
+template <typename Real, typename F, typename DF, typename D2F>
+constexpr RootResult<Real> halley(F&& f, DF&& df, D2F&& d2f, Real x0, const RootCriteria<Real>& criteria) {
+    RootResult<Real> result{x0, 0, false, 0};
+    for (result.iterations = 1; result.iterations <= criteria.max_iterations; result.iterations++) {
+        const Real fx = f(result.root);
+        result.evaluations++;
+        if (roots_detail::small_residual(fx, criteria)) {
+            result.converged = true;
+            return result;
+        }
+        const Real slope = df(result.root);
+        const Real curvature = d2f(result.root);
+        const Real denominator = 2 * slope * slope - fx * curvature;
+        if (denominator == 0) {
+            return result;
+        }
+        const Real step = 2 * fx * slope / denominator;
+        result.root -= step;
+        if (magnitude(step) <= criteria.x_tolerance) {
+            result.converged = true;
+            return result;
+        }
+    }
+    result.iterations = criteria.max_iterations;
+    return result;
+}
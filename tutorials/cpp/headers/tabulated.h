@@ -0,0 +1,282 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "accumulators.h"
+
+// Integration of sampled (x, y) data, such as the x_array and y_array that riemann_integral.cpp used to collect.
+//
+// TabulatedIntegral takes the samples in order of x, one at a time or as blocks of interleaved pairs, and keeps
+// running trapezoid and Simpson sums for arbitrary (non-uniform) spacing. It only remembers the last three samples,
+// so data of any length can be streamed through it.
+//
+//   trapezoid - sum of (x1 - x0)(y0 + y1)/2
+//   Simpson   - each pair of intervals (h0, h1) integrates the parabola through its three points:
+//               (h0 + h1)/6 [(2 - h1/h0) y0 + (h0 + h1)^2/(h0 h1) y1 + (2 - h0/h1) y2]
+//               With an odd number of intervals the last one is integrated under the parabola through the last
+//               three points, so the rule stays third order at the end.
+//
+// The file readers map a file a window at a time (64 MB by default) and feed each window to the integral, so files
+// larger than memory stream through with only one window resident; processed windows are unmapped and the kernel
+// is told the access is sequential, so it reads ahead.
+//
+//   binary - little-endian float64 pairs x0 y0 x1 y1 ..., no header
+//   CSV    - one sample per line, x and y taken from the given zero-based columns; lines whose columns do not parse
+//            as numbers (such as a header) are skipped
+//
+// The readers print the reason and return false when a file cannot be opened or mapped, like the simulation tools.
+
+class TabulatedIntegral {
+public:
+    void add(double x, double y) {
+        if (count > 0) {
+            const double h1 = x - x1;
+            trapezoid_sum.add(h1 * (y1 + y) / 2);
+            if (count % 2 == 0) {
+                // x closes the interval pair starting at x0
+                const double h0 = x1 - x0;
+                const double h = h0 + h1;
+                simpson_sum.add(h / 6 * ((2 - h1 / h0) * y0 + h * h / (h0 * h1) * y1 + (2 - h0 / h1) * y));
+            }
+        }
+        xp = x0;
+        yp = y0;
+        x0 = x1;
+        y0 = y1;
+        x1 = x;
+        y1 = y;
+        count++;
+    }
+
+    // Interleaved pairs x0 y0 x1 y1 ... The first two samples link the block to the running state one at a time;
+    // the rest are summed in bulk with eight interleaved partial sums per rule, which vectorises, and each block
+    // total then goes into the compensated sums.
+    void add(std::span<const double> xy) {
+        const std::size_t n = xy.size() / 2;
+        const std::size_t first = count;  // global index of sample 0 of the block
+        for (std::size_t j = 0; j < std::min<std::size_t>(n, 2); j++) {
+            add(xy[2 * j], xy[2 * j + 1]);
+        }
+        if (n <= 2) {
+            return;
+        }
+        const double* p = xy.data();
+        auto x = [p](std::size_t j) { return p[2 * j]; };
+        auto y = [p](std::size_t j) { return p[2 * j + 1]; };
+
+        double trapezoid_lanes[8] = {};
+        std::size_t j = 2;
+        for (; j + 8 <= n; j += 8) {
+            for (std::size_t k = 0; k < 8; k++) {
+                trapezoid_lanes[k] += (x(j + k) - x(j + k - 1)) * (y(j + k - 1) + y(j + k));
+            }
+        }
+        for (; j < n; j++) {
+            trapezoid_lanes[0] += (x(j) - x(j - 1)) * (y(j - 1) + y(j));
+        }
+
+        // interval pairs close on samples with an even global index
+        double simpson_lanes[8] = {};
+        auto pair = [&](std::size_t c) {
+            const double h0 = x(c - 1) - x(c - 2), h1 = x(c) - x(c - 1), h = h0 + h1;
+            return h * ((2 - h1 / h0) * y(c - 2) + h * h / (h0 * h1) * y(c - 1) + (2 - h0 / h1) * y(c));
+        };
+        std::size_t c = (first + 2) % 2 == 0 ? 2 : 3;
+        for (; c + 14 < n; c += 16) {
+            for (std::size_t k = 0; k < 8; k++) {
+                simpson_lanes[k] += pair(c + 2 * k);
+            }
+        }
+        for (; c < n; c += 2) {
+            simpson_lanes[0] += pair(c);
+        }
+
+        double trapezoid_block = 0, simpson_block = 0;
+        for (std::size_t k = 0; k < 8; k++) {
+            trapezoid_block += trapezoid_lanes[k];
+            simpson_block += simpson_lanes[k];
+        }
+        trapezoid_sum.add(trapezoid_block / 2);
+        simpson_sum.add(simpson_block / 6);
+        xp = x(n - 3);
+        yp = y(n - 3);
+        x0 = x(n - 2);
+        y0 = y(n - 2);
+        x1 = x(n - 1);
+        y1 = y(n - 1);
+        count = first + n;
+    }
+
+    std::size_t samples() const { return count; }
+
+    double trapezoid() const { return trapezoid_sum.total(); }
+
+    double simpson() const {
+        if (count < 3) {
+            return trapezoid();
+        }
+        if (count % 2 == 1) {
+            return simpson_sum.total();
+        }
+        // odd number of intervals: the last, [x0, x1] in the running state, under the parabola through the previous
+        // pair's end point xp, x0 and x1
+        const double h0 = x0 - xp, h1 = x1 - x0;
+        const double last = y1 * (2 * h1 * h1 + 3 * h0 * h1) / (6 * (h0 + h1)) +
+                            y0 * (h1 * h1 + 3 * h0 * h1) / (6 * h0) - yp * h1 * h1 * h1 / (6 * h0 * (h0 + h1));
+        return simpson_sum.total() + last;
+    }
+
+private:
+    NeumaierSum<double> trapezoid_sum, simpson_sum;
+    double x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+    double xp = 0, yp = 0;  // the sample before x0, for the end correction
+    std::size_t count = 0;
+};
+
+// Read-only view of [offset, offset + length) of a file. The mapping starts at the page boundary below offset.
+class MappedWindow {
+public:
+    MappedWindow(int fd, std::uint64_t offset, std::size_t length) {
+        const std::uint64_t page = static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+        const std::uint64_t start = offset / page * page;
+        mapped_length = length + (offset - start);
+        void* p = mmap(nullptr, mapped_length, PROT_READ, MAP_PRIVATE, fd, static_cast<off_t>(start));
+        if (p == MAP_FAILED) {
+            return;
+        }
+        madvise(p, mapped_length, MADV_SEQUENTIAL);
+        base = static_cast<const char*>(p);
+        view = base + (offset - start);
+        size = length;
+    }
+    MappedWindow(const MappedWindow&) = delete;
+    MappedWindow& operator=(const MappedWindow&) = delete;
+    ~MappedWindow() {
+        if (base) {
+            munmap(const_cast<char*>(base), mapped_length);
+        }
+    }
+
+    bool valid() const { return base != nullptr; }
+    const char* data() const { return view; }
+    std::size_t length() const { return size; }
+
+private:
+    const char* base = nullptr;
+    const char* view = nullptr;
+    std::size_t mapped_length = 0, size = 0;
+};
+
+namespace tabulated_detail {
+
+constexpr std::size_t default_window = std::size_t(64) << 20;
+
+// Opens path and returns its descriptor and size, or -1 after printing why not.
+inline int open_file(const std::string& path, std::uint64_t& size) {
+    int fd = open(path.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        std::cerr << "Could not open sample file " << path << std::endl;
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    size = static_cast<std::uint64_t>(st.st_size);
+    return fd;
+}
+
+// Parses column `column` of the comma-separated line [begin, end).
+inline bool parse_column(const char* begin, const char* end, std::size_t column, double& value) {
+    for (std::size_t k = 0; k < column; k++) {
+        begin = std::find(begin, end, ',');
+        if (begin == end) {
+            return false;
+        }
+        begin++;
+    }
+    while (begin < end && *begin == ' ') {
+        begin++;
+    }
+    return std::from_chars(begin, end, value).ec == std::errc();
+}
+
+}  // namespace tabulated_detail
+
+inline bool integrate_binary_file(const std::string& path, TabulatedIntegral& integral,
+                                  std::size_t window = tabulated_detail::default_window) {
+    std::uint64_t size = 0;
+    int fd = tabulated_detail::open_file(path, size);
+    if (fd < 0) {
+        return false;
+    }
+    constexpr std::size_t pair = 2 * sizeof(double);
+    window = std::max(pair, window / pair * pair);
+    const std::uint64_t usable = size / pair * pair;
+    for (std::uint64_t offset = 0; offset < usable; offset += window) {
+        MappedWindow view(fd, offset, static_cast<std::size_t>(std::min<std::uint64_t>(window, usable - offset)));
+        if (!view.valid()) {
+            std::cerr << "Could not map " << path << " at offset " << offset << std::endl;
+            close(fd);
+            return false;
+        }
+        // windows start on a whole number of pairs from the page-aligned file start, so the doubles are aligned
+        integral.add(std::span<const double>(reinterpret_cast<const double*>(view.data()),
+                                             view.length() / sizeof(double)));
+    }
+    close(fd);
+    return true;
+}
+
+inline bool integrate_csv_file(const std::string& path, TabulatedIntegral& integral, std::size_t x_column = 0,
+                               std::size_t y_column = 1, std::size_t window = tabulated_detail::default_window) {
+    std::uint64_t size = 0;
+    int fd = tabulated_detail::open_file(path, size);
+    if (fd < 0) {
+        return false;
+    }
+    std::uint64_t offset = 0;
+    while (offset < size) {
+        const std::size_t length = static_cast<std::size_t>(std::min<std::uint64_t>(window, size - offset));
+        MappedWindow view(fd, offset, length);
+        if (!view.valid()) {
+            std::cerr << "Could not map " << path << " at offset " << offset << std::endl;
+            close(fd);
+            return false;
+        }
+        const char* p = view.data();
+        const char* end = p + view.length();
+        const bool last_window = offset + length == size;
+        while (p < end) {
+            const char* eol = std::find(p, end, '\n');
+            if (eol == end && !last_window) {
+                break;  // a line cut by the window; the next window starts with it
+            }
+            double x, y;
+            if (tabulated_detail::parse_column(p, eol, x_column, x) &&
+                tabulated_detail::parse_column(p, eol, y_column, y)) {
+                integral.add(x, y);
+            }
+            p = eol + (eol < end ? 1 : 0);
+        }
+        if (p == view.data() && !last_window) {
+            window *= 2;  // a single line longer than the window
+            continue;
+        }
+        offset += static_cast<std::uint64_t>(p - view.data());
+    }
+    close(fd);
+    return true;
+}
@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "headers/implied_volatility.h"
+#include "headers/roots.h"
+
+// Build: g++ -std=c++20 -O3 -march=native -pthread implied_volatility.cpp -o implied_volatility
+
+// Closing prices (column 5) of the quant notebooks' NVIDIA data, oldest first; empty if the file cannot be read.
+std::vector<double> read_closes(const std::string& path) {
+    std::vector<double> closes;
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line);  // header
+    while (std::getline(in, line)) {
+        std::stringstream fields(line);
+        std::string field;
+        for (int column = 0; column < 5 && std::getline(fields, field, ','); column++) {
+        }
+        closes.push_back(std::stod(field));
+    }
+    return closes;
+}
+
+int main(int argc, char** argv) {
+    std::cout << "Implied Volatility -- Black-Scholes prices and volatilities in batches\n" << std::endl;
+
+    // spot and annualised realised volatility from the last year of daily log returns
+    const std::string path = argc > 1 ? argv[1] : "../../datasets/nvidia_stock_data_2024.csv";
+    const std::vector<double> closes = read_closes(path);
+    double spot = 140.0, realised = 0.5;
+    if (closes.size() > 253) {
+        const std::size_t days = 252;
+        double sum = 0, sum2 = 0;
+        for (std::size_t i = closes.size() - days; i < closes.size(); i++) {
+            const double r = std::log(closes[i] / closes[i - 1]);
+            sum += r;
+            sum2 += r * r;
+        }
+        spot = closes.back();
+        realised = std::sqrt((sum2 - sum * sum / days) / (days - 1) * 252);
+    } else {
+        std::cerr << "could not read " << path << ", using spot " << spot << " and volatility " << realised
+                  << std::endl;
+    }
+    std::cout << "NVDA spot " << spot << ", realised volatility " << realised << " (last 252 days)" << std::endl;
+
+    // a synthetic chain: a skewed smile around the realised volatility, priced and then solved back
+    const double rate = 0.045, dividend = 0.0003;
+    std::cout << "\nexpiry  strike   call/put   model vol        price   implied vol      error" << std::endl;
+    for (double expiry : {1.0 / 12, 0.5, 2.0}) {
+        const double forward = spot * std::exp((rate - dividend) * expiry), discount = std::exp(-rate * expiry);
+        for (double moneyness : {0.6, 0.8, 1.0, 1.25, 1.6}) {
+            const double strike = std::round(spot * moneyness);
+            const double k = std::log(strike / forward);
+            const double vol = realised * (1 - 0.25 * k + 0.4 * k * k);
+            const bool call = strike >= forward;  // out of the money, as quoted
+            const double price = black_scholes_price(spot, strike, vol, expiry, rate, dividend, call);
+            const double implied = implied_volatility(price, forward, strike, expiry, call, discount);
+            std::cout << std::fixed << std::setprecision(3) << std::setw(6) << expiry << std::setw(8)
+                      << std::setprecision(0) << strike << std::setw(11) << (call ? "call" : "put")
+                      << std::setprecision(6) << std::setw(12) << vol << std::setw(13) << price << std::setw(14)
+                      << implied << std::defaultfloat << std::setprecision(3) << std::setw(11) << implied - vol
+                      << std::setprecision(6) << std::endl;
+        }
+    }
+
+    // the root-finding tutorial's way: bisection on price(vol) - price, for comparison
+    const double forward = spot * std::exp(rate * 0.5), strike = std::round(spot * 1.1);
+    const double target = black_price(forward, strike, realised, 0.5, true);
+    auto error = [&](double v) { return black_price(forward, strike, v, 0.5, true) - target; };
+    RootResult<double> bisected = bisection(error, 1e-4, 5.0, RootCriteria<double>{1e-14, 0.0, 200});
+    std::cout << "\nbisection: " << bisected.evaluations << " prices for an error of "
+              << std::abs(bisected.root - realised) << "; rational guess + 2 Householder steps: "
+              << std::abs(implied_volatility(target, forward, strike, 0.5, true) - realised) << std::endl;
+
+    // throughput: random options with strikes within 3 standard deviations of the forward
+    const std::size_t n = 4'000'000;
+    std::vector<double> forwards(n), strikes(n), expiries(n), discounts(n), vols(n), prices(n), implied(n);
+    std::vector<unsigned char> calls(n);
+    std::mt19937_64 rng(11);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    for (std::size_t i = 0; i < n; i++) {
+        expiries[i] = 0.02 + 2.0 * unit(rng);
+        vols[i] = realised * (0.3 + 1.4 * unit(rng));
+        forwards[i] = spot * std::exp((rate - dividend) * expiries[i]);
+        strikes[i] = forwards[i] * std::exp(vols[i] * std::sqrt(expiries[i]) * (6.0 * unit(rng) - 3.0));
+        discounts[i] = std::exp(-rate * expiries[i]);
+        calls[i] = unit(rng) < 0.5;
+    }
+    const OptionArrays options{forwards, strikes, expiries, discounts, calls};
+    black_price_batch(options, vols, prices);
+
+    std::cout << "\n" << n << " random options, " << simd<double>::lanes << " lanes per group" << std::endl;
+    std::cout << "method                            M vols/s      solved   max rel error" << std::endl;
+    auto report = [&](const std::string& name, double seconds, std::size_t solved) {
+        double worst = 0.0;
+        for (std::size_t i = 0; i < n; i++) {
+            worst = std::max(worst, std::abs(implied[i] - vols[i]) / vols[i]);
+        }
+        std::cout << std::left << std::setw(32) << name << std::right << std::setw(10) << n / seconds / 1e6
+                  << std::setw(12) << solved << std::setw(16) << worst << std::endl;
+    };
+    auto start = std::chrono::steady_clock::now();
+    std::size_t solved = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        implied[i] = implied_volatility(prices[i], forwards[i], strikes[i], expiries[i], calls[i], discounts[i]);
+        solved += std::isnan(implied[i]) ? 0 : 1;
+    }
+    report("scalar, 1 thread", std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(),
+           solved);
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads : {1u, cores}) {
+        BatchRootOptions parallel;
+        parallel.threads = threads;
+        start = std::chrono::steady_clock::now();
+        solved = implied_volatility_batch(options, prices, implied, parallel);
+        report("batch, " + std::to_string(threads) + (threads == 1 ? " thread" : " threads"),
+               std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), solved);
+        if (cores == 1) {
+            break;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "headers/monte_carlo.h"
+#include "headers/parallel_chunks.h"
+#include "headers/random_streams.h"
+
+// Build: g++ -std=c++20 -O3 -march=native -fno-math-errno -pthread monte_carlo_integration.cpp -o monte_carlo_integration
+// (-fno-math-errno lets the sqrt in the normal generator vectorise)
+
+double continuous_function(double x, double m, double c) {
+    return m * x + c;
+}
+
+// Samples per second of one distribution, with every thread filling a cache-sized buffer from its own stream.
+template <typename Fill>
+double throughput(unsigned threads, std::size_t per_thread, Fill fill) {
+    std::vector<double> sink(threads);
+    auto start = std::chrono::steady_clock::now();
+    parallel_chunks(threads, threads, [&](std::size_t t) {
+        Philox4x32 rng(1, t);
+        std::vector<double> buffer(4096);
+        double sum = 0.0;
+        for (std::size_t done = 0; done < per_thread; done += buffer.size()) {
+            fill(rng, std::span<double>(buffer));
+            sum += buffer[0];
+        }
+        sink[t] = sum;
+    });
+    auto end = std::chrono::steady_clock::now();
+    return threads * static_cast<double>(per_thread) / std::chrono::duration<double>(end - start).count();
+}
+
+int main() {
+    std::cout << "Monte Carlo Integration -- Random Streams and Variance Reduction" << std::endl;
+
+    // generator throughput
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t per_thread = std::size_t(1) << 26;
+    std::cout << "\nGenerator throughput, Philox4x32 streams (G samples/s)" << std::endl;
+    std::cout << "threads   uniform    normal    exponential" << std::endl;
+    for (unsigned threads = 1; threads <= cores; threads *= 2) {
+        double uniform = throughput(threads, per_thread, [](Philox4x32& g, std::span<double> b) { fill_uniform(g, b); });
+        double normal = throughput(threads, per_thread, [](Philox4x32& g, std::span<double> b) { fill_normal(g, b); });
+        double exponential =
+            throughput(threads, per_thread, [](Philox4x32& g, std::span<double> b) { fill_exponential(g, b); });
+        std::cout << threads << "\t" << uniform / 1e9 << "\t" << normal / 1e9 << "\t" << exponential / 1e9
+                  << std::endl;
+    }
+
+    // integration with each variance reduction method
+    struct Integrand {
+        const char* name;
+        double (*f)(double);
+        double a, b, exact;
+    };
+    const Integrand integrands[] = {
+        {"m x + c, m = -1, c = 0, from 5 to 0", [](double x) { return continuous_function(x, -1.0, 0.0); }, 5.0, 0.0,
+         12.5},
+        {"exp(x) from 0 to 1", [](double x) { return std::exp(x); }, 0.0, 1.0, std::exp(1.0) - 1.0},
+        {"sqrt(1 - x^2) from 0 to 1", [](double x) { return std::sqrt(1.0 - x * x); }, 0.0, 1.0,
+         std::acos(-1.0) / 4},
+    };
+    const struct {
+        const char* name;
+        VarianceReduction method;
+    } methods[] = {{"none", VarianceReduction::none},
+                   {"antithetic", VarianceReduction::antithetic},
+                   {"stratified", VarianceReduction::stratified},
+                   {"control variate", VarianceReduction::control_variate}};
+    const std::size_t samples = std::size_t(1) << 24;
+    std::cout << std::scientific << std::setprecision(3);
+    for (const Integrand& integrand : integrands) {
+        std::cout << "\n" << integrand.name << ", " << samples << " samples" << std::endl;
+        std::cout << "  method              estimate      |error|    std. error    G samples/s" << std::endl;
+        for (const auto& method : methods) {
+            auto start = std::chrono::steady_clock::now();
+            MonteCarloResult r = monte_carlo_integrate(integrand.f, integrand.a, integrand.b, samples, method.method);
+            auto end = std::chrono::steady_clock::now();
+            double seconds = std::chrono::duration<double>(end - start).count();
+            std::cout << "  " << std::left << std::setw(16) << method.name << std::right << std::setw(14) << r.value
+                      << std::setw(12) << std::abs(r.value - integrand.exact) << std::setw(12) << r.error
+                      << std::setw(12) << r.samples / seconds / 1e9 << std::endl;
+        }
+    }
+
+    // central limit theorem: the mean of n unit exponentials has skewness 2 / sqrt(n)
+    std::cout << std::defaultfloat << std::setprecision(4);
+    std::cout << "\nCentral limit theorem: skewness of the mean of n exponential samples (1e6 means each)" << std::endl;
+    std::cout << "n       mean      variance   skewness   2/sqrt(n)" << std::endl;
+    Philox4x32 rng(2024);
+    for (std::size_t n : {1, 4, 16, 64}) {
+        const std::size_t means = 1'000'000;
+        std::vector<double> draws(n * 1000), mean(means);
+        for (std::size_t first = 0; first < means; first += 1000) {
+            fill_exponential(rng, std::span<double>(draws));
+            for (std::size_t i = 0; i < 1000; i++) {
+                double sum = 0.0;
+                for (std::size_t k = 0; k < n; k++) {
+                    sum += draws[i * n + k];
+                }
+                mean[first + i] = sum / static_cast<double>(n);
+            }
+        }
+        double m1 = 0.0, m2 = 0.0, m3 = 0.0;
+        for (double x : mean) {
+            m1 += x;
+        }
+        m1 /= means;
+        for (double x : mean) {
+            m2 += (x - m1) * (x - m1);
+            m3 += (x - m1) * (x - m1) * (x - m1);
+        }
+        m2 /= means;
+        m3 /= means;
+        std::cout << n << "\t" << m1 << "\t" << m2 << "\t" << m3 / std::pow(m2, 1.5) << "\t"
+                  << 2.0 / std::sqrt(static_cast<double>(n)) << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "headers/cubature.h"
+
+// Build: g++ -std=c++20 -O3 -march=native -pthread multidimensional_integration.cpp -o multidimensional_integration
+
+// prod (pi/2) sin(pi x_k) over the unit cube; integral 1 in every dimension
+double sine_product(std::span<const double> x) {
+    const double half_pi = std::acos(-1.0) / 2;
+    double p = 1.0;
+    for (double v : x) {
+        p *= half_pi * std::sin(2 * half_pi * v);
+    }
+    return p;
+}
+
+// exp(-|x - centre|^2) over the unit cube; integral (sqrt(pi) erf(1/2))^d
+double gaussian(std::span<const double> x) {
+    double r2 = 0.0;
+    for (double v : x) {
+        r2 += (v - 0.5) * (v - 0.5);
+    }
+    return std::exp(-r2);
+}
+
+template <typename Method>
+void report(const char* name, double exact, Method&& method) {
+    auto start = std::chrono::steady_clock::now();
+    CubatureResult r = method();
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << "  " << std::left << std::setw(14) << name << std::right << std::setw(10) << r.evaluations
+              << std::setw(14) << std::abs(r.value - exact) << std::setw(14) << r.error << std::setw(12) << seconds
+              << std::endl;
+}
+
+int main() {
+    std::cout << "Multidimensional Integration -- Cubature and Quasi-Monte Carlo" << std::endl;
+    std::cout << "Randomised QMC and MC use 8 replicates; the estimate is their mean and its standard error."
+              << std::endl;
+    std::cout << std::scientific << std::setprecision(2);
+
+    const double gaussian_1d = std::sqrt(std::acos(-1.0)) * std::erf(0.5);
+    struct Integrand {
+        const char* name;
+        double (*f)(std::span<const double>);
+    };
+    const Integrand integrands[] = {{"sine product", sine_product}, {"gaussian", gaussian}};
+
+    for (const Integrand& integrand : integrands) {
+        for (std::size_t d : {2, 5, 10}) {
+            std::vector<double> lower(d, 0.0), upper(d, 1.0);
+            double exact = integrand.f == gaussian ? std::pow(gaussian_1d, static_cast<double>(d)) : 1.0;
+            std::cout << "\n" << integrand.name << ", d = " << d << std::endl;
+            std::cout << "  method         evaluations     |error|   est. error     seconds" << std::endl;
+            if (d <= 5) {
+                for (int order : {4, 8, 16}) {
+                    if (std::pow(order, static_cast<double>(d)) > 2e7) {
+                        continue;
+                    }
+                    std::string name = "gauss n=" + std::to_string(order);
+                    report(name.c_str(), exact, [&] { return tensor_gauss(integrand.f, lower, upper, order); });
+                }
+            }
+            for (std::size_t points : {std::size_t(1) << 12, std::size_t(1) << 16, std::size_t(1) << 20}) {
+                report("sobol", exact,
+                       [&] { return quasi_monte_carlo(integrand.f, lower, upper, points, Sequence::sobol); });
+                report("halton", exact,
+                       [&] { return quasi_monte_carlo(integrand.f, lower, upper, points, Sequence::halton); });
+                report("monte carlo", exact, [&] { return monte_carlo(integrand.f, lower, upper, points); });
+            }
+        }
+    }
+    return 0;
+}
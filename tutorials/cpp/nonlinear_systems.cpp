@@ -0,0 +1,125 @@
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "headers/nonlinear_systems.h"
+
+// Build: g++ -std=c++20 -O3 -march=native nonlinear_systems.cpp -o nonlinear_systems
+
+// Broyden's tridiagonal function (More, Garbow and Hillstrom 1981):
+//   F_i = (3 - 2 x_i) x_i - x_{i-1} - 2 x_{i+1} + 1, with x_0 = x_{n+1} = 0, started from x = -1
+void broyden_tridiagonal(std::span<const double> x, std::span<double> out) {
+    const std::size_t n = x.size();
+    for (std::size_t i = 0; i < n; i++) {
+        const double left = i > 0 ? x[i - 1] : 0.0;
+        const double right = i + 1 < n ? x[i + 1] : 0.0;
+        out[i] = (3 - 2 * x[i]) * x[i] - left - 2 * right + 1;
+    }
+}
+
+void broyden_tridiagonal_jacobian(std::span<const double> x, std::span<double> j) {
+    const std::size_t n = x.size();
+    std::fill(j.begin(), j.end(), 0.0);
+    for (std::size_t i = 0; i < n; i++) {
+        j[i * n + i] = 3 - 4 * x[i];
+        if (i > 0) {
+            j[i * n + i - 1] = -1;
+        }
+        if (i + 1 < n) {
+            j[i * n + i + 1] = -2;
+        }
+    }
+}
+
+// The discrete integral equation function (More, Garbow and Hillstrom 1981), whose Jacobian is dense:
+//   F_i = x_i + h/2 [(1 - t_i) sum_{j <= i} t_j (x_j + t_j + 1)^3 + t_i sum_{j > i} (1 - t_j)(x_j + t_j + 1)^3]
+// with t_i = i h, h = 1/(n + 1), started from x_j = t_j (t_j - 1). Both sums are running sums, so F costs O(n).
+void integral_equation(std::span<const double> x, std::span<double> out) {
+    const std::size_t n = x.size();
+    const double h = 1.0 / double(n + 1);
+    auto cube = [&](std::size_t j) {
+        const double u = x[j] + h * double(j + 1) + 1;
+        return u * u * u;
+    };
+    double above = 0.0;
+    for (std::size_t j = 0; j < n; j++) {
+        above += (1 - h * double(j + 1)) * cube(j);
+    }
+    double below = 0.0;
+    for (std::size_t i = 0; i < n; i++) {
+        const double t = h * double(i + 1);
+        below += t * cube(i);
+        above -= (1 - t) * cube(i);
+        out[i] = x[i] + h / 2 * ((1 - t) * below + t * above);
+    }
+}
+
+// Solves from start `repeats` times with the same solver, so every solve after the first reuses its workspace, and
+// prints the statistics of the last solve with the mean time.
+template <typename Solve>
+void benchmark(const std::string& name, const std::vector<double>& start, int repeats, Solve&& solve) {
+    std::vector<double> x;
+    SystemResult<double> result;
+    auto begin = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; r++) {
+        x = start;
+        result = solve(std::span<double>(x));
+    }
+    auto end = std::chrono::steady_clock::now();
+    const double ms = std::chrono::duration<double, std::milli>(end - begin).count() / repeats;
+    std::cout << std::left << std::setw(24) << name << std::right << std::setw(6) << result.iterations
+              << std::setw(12) << result.evaluations << std::setw(8) << result.linear_iterations << std::setw(14)
+              << std::setprecision(3) << result.residual << std::setw(12) << ms << std::setprecision(6)
+              << (result.converged ? "" : "   (not converged)") << std::endl;
+}
+
+void header() {
+    std::cout << "method                  iters  F calls   GMRES      |F(x)|          ms" << std::endl;
+}
+
+int main() {
+    std::cout << "Nonlinear Systems -- Newton, Broyden and Jacobian-free Newton-Krylov\n" << std::endl;
+    const SystemCriteria<double> criteria{1e-10, 0.0, 50};
+
+    const std::size_t n_tridiagonal = 1000;
+    const std::vector<double> tridiagonal_start(n_tridiagonal, -1.0);
+    NonlinearSolver<double> tridiagonal(n_tridiagonal);
+    std::cout << "Broyden tridiagonal function, n = " << n_tridiagonal << std::endl;
+    header();
+    benchmark("newton (Jacobian)", tridiagonal_start, 2, [&](std::span<double> x) {
+        return tridiagonal.newton(broyden_tridiagonal, broyden_tridiagonal_jacobian, x, criteria);
+    });
+    benchmark("newton (differences)", tridiagonal_start, 2, [&](std::span<double> x) {
+        return tridiagonal.newton(broyden_tridiagonal, x, criteria);
+    });
+    benchmark("broyden", tridiagonal_start, 2, [&](std::span<double> x) {
+        return tridiagonal.broyden(broyden_tridiagonal, broyden_tridiagonal_jacobian, x, criteria);
+    });
+    benchmark("newton-krylov", tridiagonal_start, 100, [&](std::span<double> x) {
+        return tridiagonal.newton_krylov(broyden_tridiagonal, x, criteria);
+    });
+
+    const std::size_t n_dense = 300;
+    std::vector<double> dense_start(n_dense);
+    for (std::size_t j = 0; j < n_dense; j++) {
+        const double t = double(j + 1) / double(n_dense + 1);
+        dense_start[j] = t * (t - 1);
+    }
+    NonlinearSolver<double> dense(n_dense);
+    std::cout << "\nDiscrete integral equation function (dense Jacobian), n = " << n_dense << std::endl;
+    header();
+    benchmark("newton (differences)", dense_start, 5, [&](std::span<double> x) {
+        return dense.newton(integral_equation, x, criteria);
+    });
+    benchmark("broyden", dense_start, 5, [&](std::span<double> x) {
+        return dense.broyden(integral_equation, x, criteria);
+    });
+    benchmark("newton-krylov", dense_start, 100, [&](std::span<double> x) {
+        return dense.newton_krylov(integral_equation, x, criteria);
+    });
+    return 0;
+}
@@ -0,0 +1,26 @@
+#include "headers/riemann_integral.h"
+
+// The single home of the float and double instantiations declared extern in headers/riemann_integral.h. Link it
+// into programs built with -DNUMERICS_EXTERN_TEMPLATES.
+
+template float integrate_function<float>(ScalarFunction<float>, float, float, std::size_t, Rule);
+template double integrate_function<double>(ScalarFunction<double>, double, double, std::size_t, Rule);
+template RootResult<float> bisection_function<float>(ScalarFunction<float>, float, float, float);
+template RootResult<double> bisection_function<double>(ScalarFunction<double>, double, double, double);
+template RootResult<float> newton_function<float>(ScalarFunction<float>, ScalarFunction<float>, float, float);
+template RootResult<double> newton_function<double>(ScalarFunction<double>, ScalarFunction<double>, double, double);
+template class CubicSpline<float>;
+template class CubicSpline<double>;
+
+// The constexpr routines evaluated at compile time.
+namespace {
+constexpr double cube(double x) { return x * x * x; }
+static_assert(magnitude(integrate<Rule::simpson>(cube, 0.0, 2.0, 10) - 4.0) < 1e-12);  // Simpson is exact for cubics
+constexpr double two(double x) { return x * x - 2.0; }
+constexpr double two_slope(double x) { return 2.0 * x; }
+static_assert(magnitude(bisection(two, 0.0, 2.0, 1e-12).root - 1.41421356237) < 1e-10);
+static_assert(newton(two, two_slope, 1.0, 1e-15).converged);
+constexpr double knots[] = {0.0, 1.0, 3.0};
+constexpr double values[] = {0.0, 2.0, 4.0};
+static_assert(interpolate_linear<double>(knots, values, 2.0) == 3.0);
+}  // namespace
@@ -0,0 +1,61 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <thread>
+
+#include "headers/parallel_quadrature.h"
+
+// Build: g++ -std=c++20 -O3 -march=native -pthread parallel_integral.cpp -o parallel_integral
+
+float continuous_function(float x, float m, float c) {
+    return m * x + c;
+}
+
+int main() {
+    std::cout << "Parallel Riemann Integral" << std::endl;
+    std::cout << "Chunks of partitions are summed on all cores and combined in a fixed order." << std::endl;
+
+    const float m = -1, c = 0, x_0 = 5, x_T = 0;
+    auto f = [m, c](float x) { return continuous_function(x, m, c); };
+    const std::size_t n = 1'000'000'000;
+
+    // a long integration with progress reports from the calling thread
+    ParallelOptions monitored;
+    monitored.progress_interval = std::chrono::milliseconds(500);
+    monitored.progress = [](std::size_t done, std::size_t total) {
+        std::cout << "  progress: " << 100.0 * done / total << "%" << std::endl;
+        return true;
+    };
+    std::cout << "\nTrapezoid rule, " << n << " partitions, Kahan float accumulators (exact 12.5)" << std::endl;
+    ParallelResult<float> area = integrate_parallel<Rule::trapezoid, KahanSum>(f, x_0, x_T, n, monitored);
+    std::cout << "Area: " << area.value << std::endl;
+
+    // cancellation: stop once a third of the partitions are done
+    ParallelOptions cancelling;
+    cancelling.progress_interval = std::chrono::milliseconds(10);
+    cancelling.progress = [](std::size_t done, std::size_t total) { return done * 3 < total; };
+    ParallelResult<float> stopped = integrate_parallel<Rule::trapezoid, KahanSum>(f, x_0, x_T, n, cancelling);
+    std::cout << "\nCancelled: " << (stopped.cancelled ? "yes" : "no") << " after " << stopped.partitions_done
+              << " of " << n << " partitions" << std::endl;
+
+    // scaling, and the bit pattern of the result for each thread count
+    std::cout << "\nthreads   seconds   G partitions/s   speed-up   result" << std::endl;
+    std::cout << std::hexfloat;
+    unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    double single = 0.0;
+    for (unsigned threads = 1; threads <= std::max(max_threads, 4u); threads *= 2) {
+        ParallelOptions options;
+        options.threads = threads;
+        auto start = std::chrono::steady_clock::now();
+        ParallelResult<float> r = integrate_parallel<Rule::left, KahanSum>(f, x_0, x_T, n, options);
+        auto end = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+        if (threads == 1) {
+            single = seconds;
+        }
+        std::cout << std::defaultfloat << threads << "\t" << seconds << "\t" << n / seconds / 1e9 << "\t"
+                  << single / seconds << "\t" << std::hexfloat << r.value << std::endl;
+    }
+    return 0;
+}
@@ -1,55 +1,96 @@
-#include <iostream>
+#include <chrono>
 #include <cmath>
-#include <vector>
+#include <fstream>
+#include <iostream>
+
+#include "headers/riemann_integral.h"
+
+// Build: g++ -std=c++20 -O2 riemann_integral.cpp -o riemann_integral
+// or, with the float/double instantiations compiled once:
+//        g++ -std=c++20 -O2 -DNUMERICS_EXTERN_TEMPLATES riemann_integral.cpp numerics_instantiations.cpp
 
 float continuous_function(float x, float m, float c) {
     return m * x + c;
 }
 
+// The original first-principles loop: a left-point sum in a single float, printing twice per partition.
+float first_principles_loop(std::ostream& out, float x_0, float x_T, float m, float c, int no_of_partitions) {
+    float h = (x_T - x_0) / no_of_partitions;
+    float xt = x_0;
+    float area = 0.0;
+    for (int i = 1; i < no_of_partitions + 1; i++) {
+        out << "Partititon number: " << i << std::endl;
+        float xi = xt + h;
+        float yt = continuous_function(xt, m, c);
+        area += yt * h;
+        out << "Total area: " << area << std::endl;
+        xt = xi;
+    }
+    return area;
+}
+
+template <typename Fn>
+double seconds(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
 int main() {
     std::cout << "Riemann Integral -- First Principles" << std::endl;
     std::cout << "This demonstration will show the calculation of the Riemann Integral from first principles." << std::endl;
     // first, declare the function to calculate the integral of
-    float x = 5;
     float m = -1;
     float c = 0;
-
-    float y = continuous_function(x,m,c);
-    std::cout << "Result: " << y << std::endl; 
     float x_0 = 5;
     float x_T = 0;
-    // int y_0 = continuous_function(x_0,m,c);
-    // int y_T = continuous_function(x_T,m,c);
-    
-    std::vector<float> x_array;
-    std::vector<float> y_array;
-    x_array.push_back(0);
-    y_array.push_back(continuous_function(0,m,c));
-    
-    
-    float no_of_partitions = 1000;
-    float h = (x_T - x_0)/no_of_partitions;
-    std::cout << "Partititon size: " << h << std::endl;
-
-    std::cout << "Initialising xt as initial x at time t=0" << std::endl;
-    float xt = x_0;
-    // float yt = y_0;
-    float area = 0.0;
+    auto f = [m, c](float x) { return continuous_function(x, m, c); };
 
-    for (int i = 1; i < no_of_partitions + 1; i++) {
-        std::cout << "Partititon number: " << i << std::endl;
-        float xi = xt + h;
-        float yt = continuous_function(xt, m, c);
-        // float yi = continuous_function(xi, m, c);
-        area += yt * h;
-        std::cout << "Total area: " << area << std::endl;
-        // std::cout << "X("<< i - 1 << ":" << i << "): " << xi << std::endl;
-        // std::cout << "Y(" << i - 1 << ":" << i << "): " << yi << std::endl;
-        // x_array.push_back(xi);
-        // y_array.push_back(yi);
-        xt = xi;
+    // the exact area of y = m x + c from x_0 to x_T
+    double exact = 0.5 * m * (x_T * x_T - x_0 * x_0) + c * (x_T - x_0);
+    std::cout << "Exact area: " << exact << std::endl;
+
+    std::size_t no_of_partitions = 1000;
+    std::cout << "\nArea with " << no_of_partitions << " partitions:" << std::endl;
+    for (Rule rule : {Rule::left, Rule::right, Rule::midpoint, Rule::trapezoid, Rule::simpson}) {
+        float area = integrate(f, x_0, x_T, no_of_partitions, rule);
+        std::cout << rule_name(rule) << ": " << area << " (error " << std::abs(area - exact) << ")" << std::endl;
+    }
+
+    // Convergence on a curved integrand, where the rules differ in order: the integral of sin from 0 to pi is 2.
+    std::cout << "\nError integrating sin(x) from 0 to pi:" << std::endl;
+    std::cout << "partitions   left   midpoint   trapezoid   simpson" << std::endl;
+    auto curve = [](double x) { return std::sin(x); };
+    const double pi = std::acos(-1.0);
+    for (std::size_t n : {10, 100, 1000, 10000}) {
+        std::cout << n << "\t" << std::abs(integrate<Rule::left>(curve, 0.0, pi, n) - 2.0) << "\t"
+                  << std::abs(integrate<Rule::midpoint>(curve, 0.0, pi, n) - 2.0) << "\t"
+                  << std::abs(integrate<Rule::trapezoid>(curve, 0.0, pi, n) - 2.0) << "\t"
+                  << std::abs(integrate<Rule::simpson>(curve, 0.0, pi, n) - 2.0) << std::endl;
     }
-    std::cout << "Area computed. Final total: " << area << std::endl;
 
+    // Benchmark: the old loop is bound by std::endl flushing a line per partition, so its output goes to the null
+    // device here rather than the terminal.
+    std::cout << "\nThroughput:" << std::endl;
+    std::ofstream sink("/dev/null");
+    float old_area = 0.0f;
+    double old_time = seconds([&] { old_area = first_principles_loop(sink, x_0, x_T, m, c, 1000); });
+    std::cout << "first-principles loop, 1000 partitions: " << old_area << ", " << 1000 / old_time
+              << " partitions/s" << std::endl;
+
+    // the same 1000-partition problem, repeated so that the timing is measurable
+    const int repeats = 100000;
+    for (Rule rule : {Rule::left, Rule::midpoint, Rule::trapezoid, Rule::simpson}) {
+        volatile float area = 0.0f;
+        double time = seconds([&] {
+            for (int r = 0; r < repeats; r++) {
+                area = integrate(f, x_0, x_T, no_of_partitions, rule);
+            }
+        });
+        double rate = static_cast<double>(no_of_partitions) * repeats / time;
+        std::cout << "integrate (" << rule_name(rule) << "), 1000 partitions: " << area << ", " << rate
+                  << " partitions/s (" << rate / (1000 / old_time) << "x)" << std::endl;
+    }
     return 0;
-}
\ No newline at end of file
+}
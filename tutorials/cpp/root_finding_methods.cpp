@@ -1,76 +1,74 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
 #include <iostream>
-#include <vector>
+
+#include "headers/expression.h"
+#include "headers/roots.h"
+
+// Build: g++ -std=c++20 -O3 -march=native root_finding_methods.cpp -o root_finding_methods
 
 float continuous_function(float x, float m = -2, float c = 5) {
     return m*(x-3)*(x-3)*(x-3) + c;
 };
 
-int main () {
-    std::cout << "Root Finding Methods: Bisection Method\n" << std::endl;
-    std::cout << "Use continuous function: y = 2(x-3)^3 + 5" << std::endl;
-
-    std::vector<float> x_array;
-    std::vector<float> y_array;
-
-    float y;
-    float x_t0 = 1.0;
-    float x_T = 200.0;
-    float x_mid = (x_T - x_t0)/2;
-    float epsilon = 0.01f;
-    float x_delta = (x_T - x_mid);
-    float range_min = 0;
-    float range_max = 0;
-    int decimal_places = 2;
-    float multiplier = std::pow(10.0, decimal_places);
-    std::cout << "We are sure that the root is between " << x_t0 << " and " << x_T << ".\n" << std::endl;
-    std::cout << "We need to find the root using the bisection method, so we will need to use a while loop to find the root." << std::endl;
-    std::cout << "Two new intervals are: " << x_t0 << " to " << x_mid << ", and " << x_mid << " to " << x_T << std::endl;
-    std::cout << "Our selected uncertainty is " << epsilon << ", once the interval within which the function's root is determined to be is smaller than this value, the process is concluded and the root is 'found'." << std::endl;
+// The same function in double, as an expression so Newton and Halley get exact derivatives.
+constexpr Variable x;
+constexpr auto cubic(double m, double c) {
+    return m * pow<3>(x - 3.0) + c;
+}
 
-    while (x_delta > epsilon) {
-        y = continuous_function(x_mid);
-        if (y == 0) {
-            std::cout << "Y is 0 at x = " << x_mid << ".\n" << std::endl;
-            x_delta = 0;
-            range_max = range_min = x_mid;
-        }
-        else if (y < 0) {
-            std::cout << "Function output is less than 0, (" << y << ") midpoint is new maximum." << std::endl;
-            x_T = x_mid;
-            x_mid = (x_t0 + x_T)/2;
-            std::cout << "Recomputing midpoint as " << x_mid << "." << std::endl;
-            x_delta = (x_T - x_mid);
-            std::cout << "Recomputing delta_x: " << x_delta << "." << std::endl;
-            range_max = x_T;
-            range_min = x_t0;
-        }
-        else {
-            std::cout << "Function output is greater than 0, (" << y << ") midpoint is new minimum." << std::endl;
-            x_t0 = x_mid;
-            x_mid = (x_t0 + x_T)/2;
-            std::cout << "Recomputing midpoint as " << x_mid << "." << std::endl;
-            x_delta = (x_T - x_mid);
-            std::cout << "Recomputing delta_x: " << x_delta << "." << std::endl;
-            range_max = x_T;
-            range_min = x_t0;
-        }
+// Runs solve(c) for many values of c, so the compiler cannot hoist the solve out of the loop, and reports the mean
+// iterations, evaluations and time per solve.
+template <typename Solve>
+void benchmark(const char* name, Solve&& solve) {
+    const int solves = 1'000'000;
+    double checksum = 0.0;
+    long iterations = 0, evaluations = 0;
+    int failures = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int k = 0; k < solves; k++) {
+        RootResult<double> r = solve(5.0 + 0.001 * (k % 1000));
+        checksum += r.root;
+        iterations += r.iterations;
+        evaluations += r.evaluations;
+        failures += r.converged ? 0 : 1;
     }
-    if (range_max != range_min) {
-        std::cout << "Root is determined to be between " << range_min << " and " << range_max << "." << std::endl;
-        float range_mid = (range_min + range_max)/2;
+    auto end = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / solves;
+    std::cout << std::left << std::setw(12) << name << std::right << std::setw(10) << double(iterations) / solves
+              << std::setw(12) << double(evaluations) / solves << std::setw(12) << ns << std::setw(10) << failures
+              << std::setw(20) << std::setprecision(12) << checksum / solves << std::setprecision(6) << std::endl;
+}
 
-        std::cout << "Root is approx. ~" << round(range_mid * multiplier)/multiplier << std::endl;
-    }
-    else {
-        std::cout << "Root found at " << range_max << std::endl;
-    }
-    // for (float i = -5.0; i < 21.0; i++){        
-    //     y = continuous_function(i);
-    //     // push units into arrays
-    //     x_array.push_back(i);
-    //     y_array.push_back(y);
-    //     std::cout << "X:" << i << " Y:" << y << std::endl;
-    // }
+int main () {
+    std::cout << "Root Finding Methods\n" << std::endl;
+    std::cout << "Use continuous function: y = -2(x-3)^3 + 5" << std::endl;
+    std::cout << "The exact root is 3 + cbrt(2.5) = " << std::setprecision(12) << 3 + std::cbrt(2.5)
+              << std::setprecision(6) << std::endl;
+
+    // the original tutorial: bisection on [1, 200] to within 0.01, now from the library
+    RootResult<float> tutorial = bisection([](float v) { return continuous_function(v); }, 1.0f, 200.0f, 0.01f);
+    std::cout << "\nBisection on [1, 200] with uncertainty 0.01: root ~" << tutorial.root << " after "
+              << tutorial.iterations << " halvings" << std::endl;
 
+    // every method to 1e-12, on the bracket [1, 200] or from the starting guess x = 10
+    const RootCriteria<double> criteria{1e-12, 0.0, 200};
+    std::cout << "\nAll methods to |dx| <= 1e-12; bracketing methods on [1, 200], open methods from x = 10" << std::endl;
+    std::cout << "method      iterations evaluations  ns/solve  failures           mean root" << std::endl;
+    benchmark("bisection", [&](double c) { return bisection(cubic(-2, c), 1.0, 200.0, criteria); });
+    benchmark("brent", [&](double c) { return brent(cubic(-2, c), 1.0, 200.0, criteria); });
+    benchmark("itp", [&](double c) { return itp(cubic(-2, c), 1.0, 200.0, criteria); });
+    benchmark("secant", [&](double c) { return secant(cubic(-2, c), 10.0, 11.0, criteria); });
+    benchmark("newton", [&](double c) { return newton(cubic(-2, c), 10.0, criteria); });
+    benchmark("halley", [&](double c) { return halley(cubic(-2, c), 10.0, criteria); });
 
-}
\ No newline at end of file
+    // stopping on the residual instead: |f(x)| <= 1e-9 is reached before the step is tiny
+    const RootCriteria<double> residual{0.0, 1e-9, 200};
+    std::cout << "\nThe same, stopping on |f(x)| <= 1e-9" << std::endl;
+    std::cout << "method      iterations evaluations  ns/solve  failures           mean root" << std::endl;
+    benchmark("brent", [&](double c) { return brent(cubic(-2, c), 1.0, 200.0, residual); });
+    benchmark("newton", [&](double c) { return newton(cubic(-2, c), 10.0, residual); });
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+#include "headers/accumulators.h"
+#include "headers/batch_quadrature.h"
+#include "headers/quadrature.h"
+
+// Build: g++ -std=c++20 -O3 -march=native summation_accuracy.cpp -o summation_accuracy
+// (no -ffast-math: it would optimise the Kahan and Neumaier compensation away)
+
+float continuous_function(float x, float m, float c) {
+    return m * x + c;
+}
+
+// The first-principles loop of riemann_integral.cpp without the printing: x advanced by repeated addition.
+float repeated_addition(float x_0, float x_T, float m, float c, std::size_t no_of_partitions) {
+    float h = (x_T - x_0) / no_of_partitions;
+    float xt = x_0;
+    float area = 0.0;
+    for (std::size_t i = 0; i < no_of_partitions; i++) {
+        area += continuous_function(xt, m, c) * h;
+        xt = xt + h;
+    }
+    return area;
+}
+
+template <typename Fn>
+void row(const char* name, double exact, std::size_t n, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    double value = fn();
+    auto end = std::chrono::steady_clock::now();
+    double time = std::chrono::duration<double>(end - start).count();
+    std::cout << name << "\t" << std::abs(value - exact) / std::abs(exact) << "\t" << n / time / 1e6 << std::endl;
+}
+
+int main() {
+    std::cout << "Summation Accuracy vs Throughput" << std::endl;
+    std::cout << "Left-point area of y = -x + 1 from 5 to 0, in float unless stated." << std::endl;
+
+    const float m = -1, c = 1, x_0 = 5, x_T = 0;
+    auto f = [m, c](float x) { return continuous_function(x, m, c); };
+    auto f_double = [](double x) { return -x + 1.0; };
+    const LinearIntegrand<float> simd_f{m, c};
+
+    for (std::size_t n : {1000000, 10000000, 100000000, 1000000000}) {
+        // the left sum of a straight line has a known closed form, so the reference is exact for every n
+        double h = (x_T - x_0) / static_cast<double>(n);
+        double exact = h * (n * (-x_0 + 1.0) - h * (static_cast<double>(n) * (n - 1) / 2.0));
+        std::cout << "\n" << n << " partitions" << std::endl;
+        std::cout << "accumulator                      relative error   M points/s" << std::endl;
+        row("float, x += h, naive           ", exact, n, [&] { return repeated_addition(x_0, x_T, m, c, n); });
+        row("float, x = x0 + i h, naive     ", exact, n, [&] { return integrate<Rule::left, NaiveSum>(f, x_0, x_T, n); });
+        row("float, Kahan                   ", exact, n, [&] { return integrate<Rule::left, KahanSum>(f, x_0, x_T, n); });
+        row("float, Neumaier                ", exact, n, [&] { return integrate<Rule::left, NeumaierSum>(f, x_0, x_T, n); });
+        row("float, pairwise                ", exact, n, [&] { return integrate<Rule::left, PairwiseSum>(f, x_0, x_T, n); });
+        row("float, batched SIMD pairwise   ", exact, n, [&] { return integrate_batched<Rule::left>(simd_f, x_0, x_T, n); });
+        row("double, naive                  ", exact, n,
+            [&] { return integrate<Rule::left, NaiveSum>(f_double, double(x_0), double(x_T), n); });
+        row("double, Neumaier               ", exact, n,
+            [&] { return integrate<Rule::left, NeumaierSum>(f_double, double(x_0), double(x_T), n); });
+    }
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "headers/tabulated.h"
+
+// Build: g++ -std=c++20 -O3 -march=native tabulated_integration.cpp -o tabulated_integration
+// Usage: ./tabulated_integration [megabytes of binary samples, default 256]
+//
+// Writes y = sin(x) sampled at jittered, non-uniform x to samples.bin and samples.csv in the current directory,
+// integrates both files by streaming them through memory-mapped windows, and removes them. Throughput is compared
+// with a plain pass over the same mapped windows. Files that fit in the page cache are read from memory on the
+// second pass; give a size larger than RAM to measure the disk.
+
+// Sample i of n over [0, span]: evenly spaced, with each interior point moved by up to 30% of the spacing.
+double sample_x(std::uint64_t i, std::uint64_t n, double span) {
+    const double h = span / static_cast<double>(n - 1);
+    if (i == 0 || i == n - 1) {
+        return static_cast<double>(i) * h;
+    }
+    std::uint64_t z = i * 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 31)) * 0xbf58476d1ce4e5b9ull;
+    const double jitter = static_cast<double>(z >> 11) * 0x1p-53 - 0.5;  // in [-0.5, 0.5)
+    return (static_cast<double>(i) + 0.6 * jitter) * h;
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    std::cout << "Tabulated Integration -- Streaming Sampled Data from Files" << std::endl;
+    const double span = 20.0;
+    const double exact = 1.0 - std::cos(span);
+
+    // order of accuracy on non-uniform samples
+    std::cout << "\nIntegral of sin(x) from 0 to " << span << " over jittered samples (exact " << exact << ")"
+              << std::endl;
+    std::cout << "samples      trapezoid error   simpson error" << std::endl;
+    for (std::uint64_t n : {101, 1001, 10001, 100000}) {
+        TabulatedIntegral integral;
+        for (std::uint64_t i = 0; i < n; i++) {
+            double x = sample_x(i, n, span);
+            integral.add(x, std::sin(x));
+        }
+        std::cout << n << "\t\t" << integral.trapezoid() - exact << "\t" << integral.simpson() - exact << std::endl;
+    }
+
+    // sample files
+    const std::uint64_t megabytes = argc > 1 ? std::stoull(argv[1]) : 256;
+    const std::uint64_t n = megabytes * (1 << 20) / 16;
+    const std::uint64_t csv_n = std::min<std::uint64_t>(n, 4'000'000);
+    {
+        std::ofstream binary("samples.bin", std::ios::binary);
+        std::ofstream csv("samples.csv");
+        if (!binary || !csv) {
+            std::cerr << "Could not create samples.bin and samples.csv" << std::endl;
+            return 1;
+        }
+        std::vector<double> buffer;
+        buffer.reserve(1 << 16);
+        for (std::uint64_t i = 0; i < n; i++) {
+            double x = sample_x(i, n, span);
+            buffer.push_back(x);
+            buffer.push_back(std::sin(x));
+            if (buffer.size() == buffer.capacity() || i == n - 1) {
+                binary.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(double));
+                buffer.clear();
+            }
+        }
+        csv << "x,y\n";
+        char line[64];
+        for (std::uint64_t i = 0; i < csv_n; i++) {
+            double x = sample_x(i, csv_n, span);
+            int length = std::snprintf(line, sizeof(line), "%.17g,%.17g\n", x, std::sin(x));
+            csv.write(line, length);
+        }
+    }
+
+    std::cout << "\nfile          samples      seconds   GB/s     trapezoid error   simpson error" << std::endl;
+    // reference: the fastest a pass over the mapped windows can be
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::uint64_t size = 0;
+        int fd = open("samples.bin", O_RDONLY);
+        struct stat st;
+        fstat(fd, &st);
+        size = static_cast<std::uint64_t>(st.st_size);
+        double sum = 0.0;
+        for (std::uint64_t offset = 0; offset < size; offset += tabulated_detail::default_window) {
+            MappedWindow view(fd, offset, std::min<std::uint64_t>(tabulated_detail::default_window, size - offset));
+            const double* values = reinterpret_cast<const double*>(view.data());
+            for (std::size_t i = 0; i < view.length() / sizeof(double); i++) {
+                sum += values[i];
+            }
+        }
+        close(fd);
+        double seconds = seconds_since(start);
+        std::cout << "read only\t" << n << "\t" << seconds << "\t" << size / seconds / 1e9 << "\t(sum " << sum
+                  << ")" << std::endl;
+    }
+    for (int pass = 0; pass < 2; pass++) {
+        const bool csv = pass == 1;
+        TabulatedIntegral integral;
+        auto start = std::chrono::steady_clock::now();
+        bool ok = csv ? integrate_csv_file("samples.csv", integral) : integrate_binary_file("samples.bin", integral);
+        double seconds = seconds_since(start);
+        if (!ok) {
+            return 1;
+        }
+        double bytes = csv ? 0.0 : 16.0 * integral.samples();
+        if (csv) {
+            std::ifstream in("samples.csv", std::ios::binary | std::ios::ate);
+            bytes = static_cast<double>(in.tellg());
+        }
+        std::cout << (csv ? "samples.csv" : "samples.bin") << "\t" << integral.samples() << "\t" << seconds << "\t"
+                  << bytes / seconds / 1e9 << "\t" << integral.trapezoid() - exact << "\t"
+                  << integral.simpson() - exact << std::endl;
+    }
+    std::remove("samples.bin");
+    std::remove("samples.csv");
+    return 0;
+}